@@ -0,0 +1,22 @@
+#ifndef OCCLUSION_BENCHMARK_H_
+#define OCCLUSION_BENCHMARK_H_
+
+#include "Utils/mathgl.h"
+#include <string>
+
+namespace TinyMinecraft {
+
+  namespace Application {
+
+    // Offline benchmark for chunk culling. Generates and meshes the world around every camera pose saved in
+    // the file, then replays the poses through Graphics::ChunkCuller and logs timings and chunk counts.
+    auto RunOcclusionBenchmark(const std::string &path) -> bool;
+
+    // Appends a camera pose to the file read by RunOcclusionBenchmark, creating the file if needed.
+    void SaveCameraPose(const std::string &path, const glm::vec3 &position, float yaw, float pitch);
+
+  }
+
+}
+
+#endif // OCCLUSION_BENCHMARK_H_
@@ -25,6 +25,15 @@ namespace TinyMinecraft {
       [[nodiscard]] inline auto GetOldPos() const -> glm::vec3 { return m_oldPos; }
       [[nodiscard]] inline auto GetNewPos() const -> glm::vec3 { return m_newPos; }
 
+      // a later move of the same player, queued in the same frame, becomes one from here to where it ends
+      inline auto Coalesce(const PlayerMovedEvent &later) -> bool {
+        if (&later.m_player != &m_player) {
+          return false;
+        }
+        m_newPos = later.m_newPos;
+        return true;
+      }
+
       [[nodiscard]] static inline auto GetStaticType() -> EventType { return EventType::PlayerMove; }
       [[nodiscard]] inline auto GetEventType() const -> EventType override { return GetStaticType(); }
 
@@ -52,7 +61,16 @@ namespace TinyMinecraft {
       [[nodiscard]] inline auto GetNewYaw() const -> float { return m_newYaw; }
       [[nodiscard]] inline auto GetNewPitch() const -> float { return m_newPitch; }
 
-      [[nodiscard]] inline static auto GetStaticType() -> EventType { return EventType::PlayerMove; }
+      inline auto Coalesce(const PlayerLookedEvent &later) -> bool {
+        if (&later.m_player != &m_player) {
+          return false;
+        }
+        m_newYaw = later.m_newYaw;
+        m_newPitch = later.m_newPitch;
+        return true;
+      }
+
+      [[nodiscard]] inline static auto GetStaticType() -> EventType { return EventType::PlayerLook; }
       [[nodiscard]] inline auto GetEventType() const -> EventType override { return GetStaticType(); }
 
       auto ToString() const -> std::string override;
@@ -20,7 +20,12 @@ namespace TinyMinecraft {
       //// ENTITY EVENTS ////
 
       // player
-      PlayerMove, BlockBreak
+      PlayerMove, PlayerLook, BlockBreak,
+
+      //// WORLD EVENTS ////
+
+      // chunk
+      ChunkLoaded
     };
 
     class Event : public Utils::Printable {
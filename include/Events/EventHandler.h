@@ -3,41 +3,108 @@
 
 #include "Events/Event.h"
 #include "Utils/Singleton.h"
+#include <atomic>
+#include <concepts>
 #include <functional>
+#include <mutex>
 #include <type_traits>
-#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace TinyMinecraft {
 
   namespace Event {
 
-    using EventHandlerFn = std::function<void(const Event &)>;
-    
+    // the concrete events only, their type is what listeners are found by
     template <typename E>
-    concept ValidEvent = std::is_base_of_v<Event, E>;
+    concept ValidEvent = std::is_base_of_v<Event, E> && !std::is_abstract_v<E>;
 
     template <typename F, typename E>
     concept ValidEventFn = std::is_invocable_r_v<void, F, const E &>;
-    
+
+    // events that fold a later one into themselves while both wait in the queue, returning whether they did
+    template <typename E>
+    concept CoalescingEvent = requires(E &event, const E &later) {
+      { event.Coalesce(later) } -> std::same_as<bool>;
+    };
+
+    template <ValidEvent E>
+    using EventListenerFn = std::function<void(const E &)>;
+
+    // Listeners are kept per event type in a vector of their own, so an event reaches them without a lookup or a
+    // cast. Trigger calls them right away; Post queues the event, from any thread, until the main thread calls
+    // DispatchQueued, and merges it into the one queued before it when the event is coalescing.
     class EventHandler : private Utils::Singleton {
     public:
 
+      // from the main thread, before the events are triggered or posted
       template <ValidEvent E, ValidEventFn<E> F>
       static void On(F &&callback) {
-        EventType event = E::GetStaticType();
+        if (Listeners<E>::s_callbacks.empty()) {
+          s_queueDispatchers.push_back(&DispatchQueue<E>);
+        }
+
+        Listeners<E>::s_callbacks.emplace_back(std::forward<F>(callback));
+        Listeners<E>::s_hasCallbacks.store(true, std::memory_order_release);
+      }
+
+      template <ValidEvent E>
+      static void Trigger(const E &event) {
+        for (const EventListenerFn<E> &callback : Listeners<E>::s_callbacks) {
+          callback(event);
+        }
+      }
 
-        s_eventListeners[event].push_back([callback](const Event &event) {
-          if (const auto *derivedEvent = dynamic_cast<const E *>(&event)) {
-            callback(*derivedEvent);
+      template <ValidEvent E>
+      static void Post(const E &event) {
+        // nothing would ever dispatch it
+        if (!Listeners<E>::s_hasCallbacks.load(std::memory_order_acquire)) {
+          return;
+        }
+
+        std::lock_guard<std::mutex> lock(Listeners<E>::s_queueMutex);
+        std::vector<E> &queue = Listeners<E>::s_queue;
+
+        if constexpr (CoalescingEvent<E>) {
+          if (!queue.empty() && queue.back().Coalesce(event)) {
+            return;
           }
-        });
+        }
+
+        queue.push_back(event);
       }
 
-      static void Trigger(const Event &event);
+      // triggers the posted events, in the order they were posted for each type, on the calling thread
+      static void DispatchQueued();
 
     private:
 
-      static std::unordered_map<EventType, std::vector<EventHandlerFn>> s_eventListeners;
+      template <ValidEvent E>
+      struct Listeners {
+        static inline std::vector<EventListenerFn<E>> s_callbacks;
+        static inline std::atomic<bool> s_hasCallbacks = false;
+
+        static inline std::mutex s_queueMutex;
+        // swapped while dispatching, so neither allocates once they have grown
+        static inline std::vector<E> s_queue, s_dispatching;
+      };
+
+      template <ValidEvent E>
+      static void DispatchQueue() {
+        std::vector<E> &events = Listeners<E>::s_dispatching;
+        {
+          std::lock_guard<std::mutex> lock(Listeners<E>::s_queueMutex);
+          std::swap(events, Listeners<E>::s_queue);
+        }
+
+        for (const E &event : events) {
+          Trigger(event);
+        }
+        events.clear();
+      }
+
+      // one for each event type with listeners
+      static std::vector<void (*)()> s_queueDispatchers;
 
     };
 
@@ -40,7 +40,7 @@ namespace TinyMinecraft {
     public:
       explicit KeyReleasedEvent(int keyCode) : KeyEvent(keyCode) {}
 
-      [[nodiscard]] inline static auto GetStaticType() -> EventType { return EventType::KeyPressed; }
+      [[nodiscard]] inline static auto GetStaticType() -> EventType { return EventType::KeyReleased; }
       [[nodiscard]] inline auto GetEventType() const -> EventType override { return GetStaticType(); }
 
       [[nodiscard]] auto ToString() const -> std::string override;
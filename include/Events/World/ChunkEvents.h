@@ -0,0 +1,36 @@
+#ifndef CHUNK_EVENTS_H_
+#define CHUNK_EVENTS_H_
+
+#include "Events/Event.h"
+#include "Utils/mathgl.h"
+
+namespace TinyMinecraft {
+
+  namespace Event {
+
+    // posted by the chunk workers when a mesh of the chunk is ready, every time it is remeshed too
+    class ChunkLoadedEvent : public Event {
+    public:
+      explicit ChunkLoadedEvent(const glm::ivec2 &chunkPos, int meshLevel)
+        : m_chunkPos(chunkPos)
+        , m_meshLevel(meshLevel)
+      {}
+
+      [[nodiscard]] inline auto GetChunkPos() const -> glm::ivec2 { return m_chunkPos; }
+      [[nodiscard]] inline auto GetMeshLevel() const -> int { return m_meshLevel; }
+
+      [[nodiscard]] inline static auto GetStaticType() -> EventType { return EventType::ChunkLoaded; }
+      [[nodiscard]] inline auto GetEventType() const -> EventType override { return GetStaticType(); }
+
+      [[nodiscard]] auto ToString() const -> std::string override;
+
+    private:
+      glm::ivec2 m_chunkPos;
+      int m_meshLevel;
+    };
+
+  }
+
+}
+
+#endif // CHUNK_EVENTS_H_
@@ -0,0 +1,47 @@
+#ifndef FRUSTUM_H_
+#define FRUSTUM_H_
+
+#include "Utils/mathgl.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace TinyMinecraft {
+
+  namespace Geometry {
+
+    // axis aligned boxes stored one coordinate per array, so the SSE path can test 4 boxes at once
+    struct BoundingBoxes {
+      std::vector<float> minX, minY, minZ;
+      std::vector<float> maxX, maxY, maxZ;
+
+      void Clear();
+      void Add(const glm::vec3 &min, const glm::vec3 &max);
+      void Set(size_t index, const glm::vec3 &min, const glm::vec3 &max);
+      // moves the last box into `index`
+      void RemoveSwap(size_t index);
+      [[nodiscard]] inline auto Size() const -> size_t { return minX.size(); }
+    };
+
+    class Frustum {
+    public:
+      Frustum() = default;
+      explicit Frustum(const glm::mat4 &viewProjection);
+
+      [[nodiscard]] auto IsBoxVisible(const glm::vec3 &min, const glm::vec3 &max) const -> bool;
+
+      // sets visible[i] for every box that intersects the frustum, returns the number of visible boxes
+      auto CullBoxes(const BoundingBoxes &boxes, std::vector<uint8_t> &visible) const -> size_t;
+
+    private:
+      // left, right, bottom, top, near, far; inside when dot(plane.xyz, p) + plane.w >= 0
+      std::array<glm::vec4, 6> m_planes;
+
+      auto CullBoxesScalar(const BoundingBoxes &boxes, size_t first, std::vector<uint8_t> &visible) const -> size_t;
+    };
+
+  }
+
+}
+
+#endif // FRUSTUM_H_
@@ -21,17 +21,24 @@ namespace TinyMinecraft {
     public:
       Mesh();
 
+      // attribute layout of MeshVertex, for the vertex buffer currently bound to GL_ARRAY_BUFFER
+      static void AddVertexAttributes(Graphics::VertexArray &vao);
+
       void ClearBuffers() {
         if (m_vertexCount > 0) {
           m_vao.Bind();
           m_vbo.CleanBuffers();
           m_ebo.CleanBuffers();
           m_vertexCount = 0;
+          m_vertexCapacity = 0;
+          m_indexCapacity = 0;
         }
       }
 
       void Update(std::vector<MeshVertex> &vertices, std::vector<GLuint> &indices);
       [[nodiscard]] inline auto GetVertexCount() const -> size_t { return m_vertexCount; }
+      // GPU bytes of the vertex and index buffers, part of MemoryCategory::GpuBuffers
+      [[nodiscard]] inline auto GetBufferSize() const -> size_t { return static_cast<size_t>(m_vbo.GetSize() + m_ebo.GetSize()); }
       inline void BindVertexArray() { m_vao.Bind(); }
 
     private:
@@ -39,6 +46,7 @@ namespace TinyMinecraft {
       Graphics::BufferObject m_vbo, m_ebo;
 
       size_t m_vertexCount = 0;
+      size_t m_vertexCapacity = 0, m_indexCapacity = 0;
     };
 
   }
@@ -0,0 +1,51 @@
+#ifndef OCCLUSION_BUFFER_H_
+#define OCCLUSION_BUFFER_H_
+
+#include "Utils/mathgl.h"
+#include <array>
+#include <vector>
+
+namespace TinyMinecraft {
+
+  namespace Geometry {
+
+    // Low resolution software depth buffer for occlusion culling. Occluders are boxes known to be opaque; each
+    // is written only to the pixels its silhouette fully covers, at the depth of its farthest corner, so the
+    // buffer never claims more occlusion than there is. Depth is clip space w, i.e. distance along the view axis.
+    class OcclusionBuffer {
+    public:
+      static constexpr int WIDTH = 256;
+      static constexpr int HEIGHT = 128;
+
+      void Clear(const glm::mat4 &viewProjection);
+
+      void AddOccluder(const glm::vec3 &min, const glm::vec3 &max);
+      // false only when every pixel the box may touch has an occluder in front of the box's nearest corner
+      [[nodiscard]] auto IsBoxVisible(const glm::vec3 &min, const glm::vec3 &max) const -> bool;
+
+      [[nodiscard]] inline auto GetDepth(int x, int y) const -> float { return m_depth[y * WIDTH + x]; }
+
+    private:
+      // up to 8 corners plus 6 points where the box edges cross the near plane
+      static constexpr int MAX_PROJECTED_POINTS = 14;
+
+      struct ProjectedBox {
+        std::array<glm::vec2, MAX_PROJECTED_POINTS> points; // in pixels
+        int pointCount = 0;
+        glm::vec2 min, max;
+        float nearDepth, farDepth;
+      };
+
+      glm::mat4 m_viewProjection { 1.0f };
+      alignas(16) std::array<float, WIDTH * HEIGHT> m_depth;
+
+      // Fails when part of the box is behind the near plane, unless `clipToNearPlane` is set, in which case
+      // only the part in front of it is projected and it fails only when nothing is left.
+      auto Project(const glm::vec3 &min, const glm::vec3 &max, bool clipToNearPlane, ProjectedBox &box) const -> bool;
+    };
+
+  }
+
+}
+
+#endif // OCCLUSION_BUFFER_H_
@@ -76,6 +76,7 @@ namespace TinyMinecraft {
     };
 
     [[nodiscard]] auto GetNormal(Face face) -> glm::vec3;
+    [[nodiscard]] auto GetOppositeFace(Face face) -> Face;
 
     [[nodiscard]] auto GetVertices(Face face, float width = 1.0f, float height = 1.0f) -> std::array<glm::vec3, 4>;
     [[nodiscard]] auto GetFluidVertices(Face face, int depth = 0, int maxDepth = 7, Face direction = Face::None, bool floating = false) -> std::array<glm::vec3, 4>;
@@ -2,6 +2,7 @@
 #define BUFFER_OBJECT_H_
 
 #include "Graphics/gfx.h"
+#include "Utils/MemoryTracker.h"
 #include "Utils/NonCopyable.h"
 #include <array>
 #include <vector>
@@ -24,20 +25,54 @@ namespace TinyMinecraft {
       inline void CleanBuffers() {
         Bind();
         glBufferData(m_target, 0, nullptr, GL_DYNAMIC_DRAW);
+        SetSize(0);
       }
 
-      template <typename T> void BufferData(const std::vector<T> &data, GLenum usage) const {
+      // storage without contents, to be filled with BufferSubData
+      inline void Allocate(GLsizeiptr size, GLenum usage) {
+        Bind();
+        glBufferData(m_target, size, nullptr, usage);
+        SetSize(size);
+      }
+
+    #ifdef GL_ARB_buffer_storage
+      // immutable storage, which is never reallocated
+      inline void AllocateStorage(GLsizeiptr size, GLbitfield flags) {
+        Bind();
+        glBufferStorage(m_target, size, nullptr, flags);
+        SetSize(size);
+      }
+    #endif
+
+      template <typename T> void BufferSubData(GLintptr offset, const std::vector<T> &data) const {
+        Bind();
+        glBufferSubData(m_target, offset, static_cast<GLsizeiptr>(sizeof(T) * data.size()), data.data());
+      }
+
+      [[nodiscard]] inline auto GetHandle() const -> GLuint { return m_handle; }
+      // bytes of the storage, counted as MemoryCategory::GpuBuffers
+      [[nodiscard]] inline auto GetSize() const -> GLsizeiptr { return m_size; }
+
+      template <typename T> void BufferData(const std::vector<T> &data, GLenum usage) {
         Bind();
         glBufferData(m_target, static_cast<GLsizeiptr>(sizeof(T) * data.size()), data.data(), usage);
+        SetSize(static_cast<GLsizeiptr>(sizeof(T) * data.size()));
       }
 
-      template <typename T, size_t Count> void BufferData(const std::array<T, Count> &data, GLenum usage) const {
+      template <typename T, size_t Count> void BufferData(const std::array<T, Count> &data, GLenum usage) {
         Bind();
         glBufferData(m_target, static_cast<GLsizeiptr>(sizeof(T) * Count), data.data(), usage);
+        SetSize(static_cast<GLsizeiptr>(sizeof(T) * Count));
       }
     private:
       GLuint m_handle;
       GLenum m_target;
+      GLsizeiptr m_size = 0;
+
+      inline void SetSize(GLsizeiptr size) {
+        Utils::MemoryTracker::Add(Utils::MemoryCategory::GpuBuffers, static_cast<int64_t>(size) - static_cast<int64_t>(m_size));
+        m_size = size;
+      }
     };
 
   }
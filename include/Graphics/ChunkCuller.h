@@ -0,0 +1,88 @@
+#ifndef CHUNK_CULLER_H_
+#define CHUNK_CULLER_H_
+
+#include "Geometry/Frustum.h"
+#include "Geometry/OcclusionBuffer.h"
+#include "Utils/NonCopyable.h"
+#include "Utils/mathgl.h"
+#include "World/Chunk.h"
+#include "World/SectionVisibility.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace TinyMinecraft {
+
+  namespace Graphics {
+
+    struct RenderStats {
+      size_t drawnChunks = 0;
+      size_t culledChunks = 0;    // outside the frustum
+      size_t occludedChunks = 0;  // inside the frustum but unreachable through the section graph
+      size_t hiddenChunks = 0;    // reachable, but behind solid sections in the software depth buffer
+      float culledSectionFraction = 0.0f;
+
+      // filled in by the renderer
+      size_t pendingMeshes = 0;   // meshed by the workers (chunks and far terrain tiles), waiting for the upload budget
+      size_t uploadedBytes = 0;   // this frame
+    };
+
+    // Decides which chunks to draw: frustum culling, then the section visibility walk, then a software depth
+    // buffer test. The depth test runs on a thread of its own between Begin and Finish so the caller can
+    // upload meshes in the meantime. Needs no GL context.
+    class ChunkCuller : public Utils::NonCopyable {
+    public:
+      // closest occluders rasterised per frame
+      static constexpr size_t MAX_OCCLUDERS = 384;
+
+      ChunkCuller();
+      ~ChunkCuller();
+
+      // `visibility` holds the mesh data of each of `chunks`; none of them may change until Finish returns
+      void Begin(const std::vector<World::Chunk *> &chunks, const std::vector<World::ChunkVisibility> &visibility, const Geometry::BoundingBoxes &bounds, const glm::mat4 &viewProjection, const glm::vec3 &cameraPos);
+      void Finish();
+
+      // valid after Finish
+      [[nodiscard]] inline auto GetVisibleChunks() const -> const std::vector<World::Chunk *> & { return m_visibleChunks; }
+      [[nodiscard]] inline auto GetStats() const -> const RenderStats & { return m_stats; }
+      [[nodiscard]] inline auto GetOcclusionBuffer() const -> const Geometry::OcclusionBuffer & { return m_occlusionBuffer; }
+
+    private:
+      struct Occluder {
+        glm::vec3 min, max;
+        float distance;
+      };
+
+      RenderStats m_stats;
+      glm::mat4 m_viewProjection { 1.0f };
+      glm::vec3 m_cameraPos { 0.0f };
+
+      // chunks inside the frustum, which is what the depth test indexes into, and their indices in the chunks
+      // passed to Begin, which is what the section walk indexes into
+      std::vector<World::Chunk *> m_frustumChunks, m_visibleChunks;
+      std::vector<World::ChunkVisibility> m_frustumVisibility;
+      std::vector<size_t> m_frustumIndices;
+      std::vector<uint8_t> m_chunkVisibility, m_chunkUnoccluded;
+      World::SectionVisibility m_sectionVisibility;
+
+      Geometry::OcclusionBuffer m_occlusionBuffer;
+      std::vector<Occluder> m_occluders;
+
+      std::thread m_thread;
+      std::mutex m_mutex;
+      std::condition_variable m_condition;
+      bool m_hasWork = false, m_shouldTerminate = false;
+
+      // `chunkIndex` into m_frustumChunks
+      [[nodiscard]] auto IsSectionReachable(size_t chunkIndex, int section) const -> bool;
+
+      void RunOcclusionThread();
+      void CullHiddenChunks();
+    };
+
+  }
+
+}
+
+#endif // CHUNK_CULLER_H_
@@ -0,0 +1,91 @@
+#ifndef CHUNK_REGIONS_H_
+#define CHUNK_REGIONS_H_
+
+#include "Geometry/Mesh.h"
+#include "Graphics/BufferObject.h"
+#include "Graphics/RangeAllocator.h"
+#include "Graphics/Shader.h"
+#include "Graphics/StreamBuffer.h"
+#include "Graphics/VertexArray.h"
+#include "Utils/NonCopyable.h"
+#include "Utils/mathgl.h"
+#include "World/Chunk.h"
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace TinyMinecraft {
+
+  namespace Graphics {
+
+    // Opaque chunk geometry batched per REGION_SIZE x REGION_SIZE chunks. Every region has one vertex and one
+    // index buffer, sub-allocated per chunk, and is drawn with a single glMultiDrawElementsBaseVertex. GL 3.3
+    // has no per-draw id for the shader, so vertices are stored relative to the region instead of the chunk.
+    class ChunkRegions : private Utils::NonCopyable {
+    public:
+      static constexpr int REGION_SIZE = 8;
+
+      ChunkRegions();
+
+      // replaces what the chunk had uploaded before
+      void Upload(World::Chunk *chunk, const World::ChunkMesh &mesh);
+      void Remove(World::Chunk *chunk);
+
+      // one draw call per region that has any of `chunks`
+      void Draw(const std::vector<World::Chunk *> &chunks, Shader &shader);
+
+      [[nodiscard]] inline auto GetRegionCount() const -> size_t { return m_regions.size(); }
+      [[nodiscard]] inline auto GetDrawCallCount() const -> size_t { return m_drawCallCount; }
+
+    private:
+      // initial capacity of a region, grown by doubling
+      static constexpr uint32_t INITIAL_VERTEX_CAPACITY = 1 << 16;
+      static constexpr uint32_t INITIAL_INDEX_CAPACITY = 3 << 15;
+      // twice the default upload budget, so a frame's uploads rarely wait for the previous frame's copies
+      static constexpr GLsizeiptr STAGING_CAPACITY = 8 << 20;
+
+      struct Region : private Utils::NonCopyable {
+        Region(const glm::ivec2 &regionPos);
+
+        glm::ivec2 origin; // first chunk
+        VertexArray vao;
+        BufferObject vbo, ebo;
+        RangeAllocator vertices, indices;
+        size_t chunkCount = 0;
+
+        // draws recorded for the current frame
+        std::vector<GLsizei> counts;
+        std::vector<const void *> offsets;
+        std::vector<GLint> baseVertices;
+
+        void Grow(uint32_t vertexCapacity, uint32_t indexCapacity);
+      };
+
+      struct Allocation {
+        Region *region;
+        uint32_t vertexOffset, vertexCount;
+        uint32_t indexOffset, indexCount;
+      };
+
+      std::unordered_map<glm::ivec2, std::unique_ptr<Region>, Utils::IVec2Hash> m_regions;
+      std::unordered_map<World::Chunk *, Allocation> m_allocations;
+
+      // uploads are written here, already in region coordinates, and copied into the region buffers by the GPU
+      StreamBuffer m_staging;
+
+      std::vector<Region *> m_drawnRegions;
+      size_t m_drawCallCount = 0;
+
+      void Free(const Allocation &allocation);
+      // copies `count` elements into `destination` starting at element `first`, in pieces that fit the staging
+      // buffer; `write(begin, count, out)` fills one piece
+      template <typename T, typename Write>
+      void Stage(const BufferObject &destination, uint32_t first, size_t count, Write &&write);
+      [[nodiscard]] static auto GetRegionPos(const glm::ivec2 &chunkPos) -> glm::ivec2;
+    };
+
+  }
+
+}
+
+#endif // CHUNK_REGIONS_H_
@@ -0,0 +1,50 @@
+#ifndef DEVICE_H_
+#define DEVICE_H_
+
+#include "Graphics/gfx.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace TinyMinecraft {
+
+  namespace Graphics {
+
+    enum class DeviceBackend : uint8_t {
+      OpenGL,     // the driver, nothing recorded
+      Recording,  // the driver, with every frame recorded
+      Null        // no driver or window; records what would have reached one
+    };
+
+    // Loads the GL functions everything in Graphics calls. The recording backends swap a few of the loaded
+    // function pointers for wrappers that count what reaches the driver, so the callers stay unchanged.
+    class Device {
+    public:
+      struct FrameStats {
+        int drawCalls = 0;
+        int stateChanges = 0;
+        int bufferAllocations = 0;
+        size_t allocatedBytes = 0;
+        // written by the CPU through glBufferData, glBufferSubData or a write mapping; persistent mappings
+        // are only seen once, when mapped
+        size_t uploadedBytes = 0;
+        // copied between buffers by the GPU
+        size_t copiedBytes = 0;
+      };
+
+      // `loader` is ignored by the Null backend
+      [[nodiscard]] static auto Initialize(DeviceBackend backend, GLADloadproc loader = nullptr) -> bool;
+
+      [[nodiscard]] static auto GetBackend() -> DeviceBackend;
+      [[nodiscard]] static auto IsRecording() -> bool;
+
+      // counts of the last finished frame, empty with the OpenGL backend
+      [[nodiscard]] static auto GetFrameStats() -> const FrameStats &;
+      [[nodiscard]] static auto GetFrameCount() -> uint64_t;
+      static void EndFrame();
+    };
+
+  }
+
+}
+
+#endif // DEVICE_H_
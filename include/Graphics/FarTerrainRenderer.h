@@ -0,0 +1,72 @@
+#ifndef FAR_TERRAIN_RENDERER_H_
+#define FAR_TERRAIN_RENDERER_H_
+
+#include "Graphics/BufferObject.h"
+#include "Graphics/Shader.h"
+#include "Graphics/Texture.h"
+#include "Graphics/VertexArray.h"
+#include "Utils/NonCopyable.h"
+#include "Utils/mathgl.h"
+#include "World/FarTerrain.h"
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace TinyMinecraft {
+
+  namespace Graphics {
+
+    // Draws the far terrain in a single glMultiDrawElementsBaseVertex. Every tile has the same vertex count and
+    // triangles, so tiles take fixed slots of one vertex buffer and share one index buffer.
+    class FarTerrainRenderer : private Utils::NonCopyable {
+    public:
+      explicit FarTerrainRenderer(const Texture &blockAtlas);
+
+      // takes the tiles built since the last frame and uploads them within `budget` bytes, returns the bytes uploaded
+      auto Update(World::FarTerrain &farTerrain, size_t budget) -> size_t;
+      // tiles in the frustum, except inside `innerRadius` blocks of `innerCenter` where the chunks are drawn
+      void Draw(const glm::mat4 &viewProjection, const glm::vec2 &innerCenter, float innerRadius);
+
+      [[nodiscard]] inline auto GetPendingCount() const -> size_t { return m_pendingTiles.size(); }
+      [[nodiscard]] inline auto GetTileCount() const -> size_t { return m_tiles.size(); }
+
+    private:
+      static constexpr uint32_t INITIAL_SLOT_COUNT = 64;
+
+      struct Slot {
+        uint32_t index;
+        glm::vec3 min, max;
+      };
+
+      using TileMap = std::unordered_map<World::FarTileKey, Slot, World::FarTileKeyHash>;
+
+      Shader m_shader;
+      VertexArray m_vao;
+      BufferObject m_vbo, m_ebo;
+
+      uint32_t m_slotCount = 0;
+      std::vector<uint32_t> m_freeSlots;
+
+      // uploaded tiles; after the selection changes, also the old tiles until the new ones are all uploaded
+      TileMap m_tiles;
+      bool m_hasRetiredTiles = false;
+      uint64_t m_selectionVersion = 0;
+
+      std::unordered_map<World::FarTileKey, std::shared_ptr<const World::FarTile>, World::FarTileKeyHash> m_pendingTiles;
+      std::vector<std::shared_ptr<const World::FarTile>> m_uploadOrder;
+
+      // draws recorded for the current frame
+      std::vector<GLsizei> m_counts;
+      std::vector<const void *> m_offsets;
+      std::vector<GLint> m_baseVertices;
+
+      void Upload(const World::FarTile &tile);
+      void Grow(uint32_t slotCount);
+      void RetireTiles(const World::FarTerrain &farTerrain);
+    };
+
+  }
+
+}
+
+#endif // FAR_TERRAIN_RENDERER_H_
@@ -0,0 +1,21 @@
+#ifndef NULL_DEVICE_H_
+#define NULL_DEVICE_H_
+
+namespace TinyMinecraft {
+
+  namespace Graphics {
+
+    // GL functions that do nothing, for running the renderer without a driver. Queries answer as a GL 3.3
+    // context without extensions where every shader compiles and links, object names are handed out in
+    // order and mapped buffer ranges point into host memory that is never read.
+    class NullDevice {
+    public:
+      // loader for gladLoadGLLoader; nullptr for functions the game does not use
+      [[nodiscard]] static auto GetProcAddress(const char *name) -> void *;
+    };
+
+  }
+
+}
+
+#endif // NULL_DEVICE_H_
@@ -0,0 +1,39 @@
+#ifndef RANGE_ALLOCATOR_H_
+#define RANGE_ALLOCATOR_H_
+
+#include <cstdint>
+#include <map>
+#include <optional>
+
+namespace TinyMinecraft {
+
+  namespace Graphics {
+
+    // First-fit free-list allocator over [0, capacity), in elements. Only does bookkeeping, the memory being
+    // handed out lives elsewhere (usually a GL buffer). Freed ranges are merged with free neighbours.
+    class RangeAllocator {
+    public:
+      explicit RangeAllocator(uint32_t capacity);
+
+      // offset of the first free range that fits, nothing if none does
+      [[nodiscard]] auto Allocate(uint32_t size) -> std::optional<uint32_t>;
+      void Free(uint32_t offset, uint32_t size);
+      // extends the range, the new space is free
+      void Grow(uint32_t capacity);
+
+      [[nodiscard]] inline auto GetCapacity() const -> uint32_t { return m_capacity; }
+      [[nodiscard]] inline auto GetFreeSize() const -> uint32_t { return m_freeSize; }
+      [[nodiscard]] inline auto GetFreeRangeCount() const -> size_t { return m_freeRanges.size(); }
+      [[nodiscard]] auto GetLargestFreeRange() const -> uint32_t;
+
+    private:
+      std::map<uint32_t, uint32_t> m_freeRanges; // offset -> size
+      uint32_t m_capacity;
+      uint32_t m_freeSize;
+    };
+
+  }
+
+}
+
+#endif // RANGE_ALLOCATOR_H_
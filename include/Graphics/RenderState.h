@@ -0,0 +1,49 @@
+#ifndef RENDER_STATE_H_
+#define RENDER_STATE_H_
+
+#include "Graphics/gfx.h"
+
+namespace TinyMinecraft {
+
+  namespace Graphics {
+
+    // Remembers the GL state set through it so redundant changes are skipped, and counts the GL calls made per
+    // frame. Code changing the tracked state directly must call Invalidate afterwards.
+    class RenderState {
+    public:
+      static constexpr GLuint MAX_TEXTURE_UNITS = 16;
+
+      struct FrameStats {
+        int stateChanges = 0;
+        int skippedStateChanges = 0;
+        int uniformUploads = 0;
+        int bufferUploads = 0;
+        int drawCalls = 0;
+
+        [[nodiscard]] inline auto GetCallCount() const -> int { return stateChanges + uniformUploads + bufferUploads + drawCalls; }
+      };
+
+      static void UseProgram(GLuint program);
+      static void BindVertexArray(GLuint vertexArray);
+      static void BindTexture(GLuint unit, GLuint texture);
+      static void SetDepthMask(bool isEnabled);
+
+      // GL unbinds deleted vertex arrays and textures, forget them too
+      static void OnVertexArrayDeleted(GLuint vertexArray);
+      static void OnTextureDeleted(GLuint texture);
+      static void Invalidate();
+
+      static void CountUniformUpload();
+      static void CountBufferUpload();
+      static void CountDrawCall();
+
+      // counts of the last finished frame
+      [[nodiscard]] static auto GetFrameStats() -> const FrameStats &;
+      static void EndFrame();
+    };
+
+  }
+
+}
+
+#endif // RENDER_STATE_H_
@@ -1,13 +1,20 @@
 #ifndef RENDERER_H_
 #define RENDERER_H_
 
+#include "Geometry/Frustum.h"
 #include "Geometry/Mesh.h"
+#include "Graphics/ChunkCuller.h"
+#include "Graphics/BufferObject.h"
+#include "Graphics/ChunkRegions.h"
+#include "Graphics/FarTerrainRenderer.h"
 #include "Graphics/Texture.h"
 #include "Graphics/Shader.h"
 #include "Scene/PlayerCameras.h"
 #include "UI/UserInterface.h"
 #include "World/World.h"
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 namespace TinyMinecraft {
 
@@ -15,6 +22,9 @@ namespace TinyMinecraft {
 
     class Renderer {
     public:
+      // of the FrameUniforms block, in every shader that reads it
+      static constexpr GLuint FRAME_UNIFORMS_BINDING = 0;
+
       Renderer(float viewportWidth, float viewportHeight);
       
       void RenderWorld(World::World &world);
@@ -31,15 +41,59 @@ namespace TinyMinecraft {
 
       inline void SetPlayerPosition(glm::vec3 &value) { m_playerPosition = value; }
 
+      [[nodiscard]] inline auto GetStats() const -> const RenderStats & { return m_stats; }
+      // bytes of chunk mesh data uploaded per frame
+      inline void SetUploadBudget(size_t bytes) { m_uploadBudget = bytes; }
+
+      // chunks that passed culling in the last RenderWorld
+      [[nodiscard]] inline auto GetVisibleChunks() const -> const std::vector<World::Chunk *> & { return m_visibleChunks; }
+
     private:
+      // std140 layout of the FrameUniforms block
+      struct FrameUniforms {
+        glm::mat4 viewProjection;
+        glm::vec4 cameraPos;
+      };
+
       Shader m_blockShader, m_waterShader;
       Texture m_blockAtlasTexture;
       glm::vec3 m_playerPosition { 0.0f };
       std::shared_ptr<Scene::PlayerCamera> m_currentCamera = nullptr;
 
       float m_viewportWidth, m_viewportHeight;
+      BufferObject m_frameUniforms;
 
       bool m_isWireframeMode = false;
+
+      RenderStats m_stats;
+      ChunkCuller m_culler;
+      ChunkRegions m_regions;
+      FarTerrainRenderer m_farTerrain;
+
+      // Loaded chunks, their bounds and the visibility data of their latest meshes, kept in sync from the
+      // world's render events
+      std::vector<World::Chunk *> m_renderList;
+      std::unordered_map<World::Chunk *, size_t> m_renderListIndex;
+      Geometry::BoundingBoxes m_chunkBounds;
+      std::vector<World::ChunkVisibility> m_chunkVisibility;
+      std::vector<World::Chunk *> m_visibleChunks;
+
+      // meshes handed over by the workers and not uploaded yet, at most one per chunk
+      std::unordered_map<World::Chunk *, std::shared_ptr<const World::ChunkMesh>> m_pendingMeshes;
+      std::vector<World::Chunk *> m_uploadOrder;
+      size_t m_uploadBudget = GFX_UPLOAD_BUDGET_BYTES;
+
+      // render list chunks with translucent blocks, farthest from m_translucentOrigin first unless the order is dirty
+      std::vector<World::Chunk *> m_translucentChunks;
+      std::unordered_map<World::Chunk *, size_t> m_translucentIndex;
+      glm::ivec2 m_translucentOrigin { 0 };
+      bool m_isTranslucentOrderDirty = false;
+
+      void UpdateRenderList(World::World &world);
+      auto UploadMeshes(const glm::ivec2 &cameraChunkPos) -> size_t;
+      void RemoveTranslucentChunk(World::Chunk *chunk);
+      void SortTranslucentChunks(const glm::ivec2 &cameraChunkPos);
+      void CullChunks();
     };
 
   }
@@ -1,12 +1,14 @@
 #ifndef SHADER_H_
 #define SHADER_H_
 
+#include "Graphics/RenderState.h"
 #include "Graphics/gfx.h"
 #include "Utils/NonCopyable.h"
 #include "Utils/NonMovable.h"
 #include "Utils/mathgl.h"
 #include <string>
 #include <string_view>
+#include <unordered_map>
 
 namespace TinyMinecraft {
 
@@ -22,56 +24,74 @@ namespace TinyMinecraft {
       Shader(const std::string &vertexPath, const std::string &fragmentPath);
       ~Shader();
 
-      inline void Use() { glUseProgram(m_programHandle); };
+      inline void Use() { RenderState::UseProgram(m_programHandle); };
 
-      template<typename T> void Uniform(const std::string &name, T value);
-      
-      void Uniform(const std::string &name, bool value) {
+      // -1 for names the program does not use, which glUniform ignores
+      [[nodiscard]] auto GetUniformLocation(const std::string &name) const -> GLint;
+      void BindUniformBlock(const std::string &name, GLuint binding);
+
+      template<typename T> void Uniform(const std::string &name, T value) {
+        Uniform(GetUniformLocation(name), value);
+      }
+
+      void Uniform(GLint location, bool value) {
         Use();
-        glUniform1i(glGetUniformLocation(m_programHandle, name.c_str()), (int) value);
+        glUniform1i(location, (int) value);
+        RenderState::CountUniformUpload();
       }
 
-      void Uniform(const std::string &name, int value) {
+      void Uniform(GLint location, int value) {
         Use();
-        glUniform1i(glGetUniformLocation(m_programHandle, name.c_str()), value);
+        glUniform1i(location, value);
+        RenderState::CountUniformUpload();
       }
 
-      void Uniform(const std::string &name, float value) {
+      void Uniform(GLint location, float value) {
         Use();
-        glUniform1f(glGetUniformLocation(m_programHandle, name.c_str()), value);
+        glUniform1f(location, value);
+        RenderState::CountUniformUpload();
       }
 
-      void Uniform(const std::string &name, glm::mat4 value) {
+      void Uniform(GLint location, glm::mat4 value) {
         Use();
-        glUniformMatrix4fv(glGetUniformLocation(m_programHandle, name.c_str()), 1, GL_FALSE, glm::value_ptr(value));
+        glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+        RenderState::CountUniformUpload();
       }
 
-      void Uniform(const std::string &name, glm::mat3 value) {
+      void Uniform(GLint location, glm::mat3 value) {
         Use();
-        glUniformMatrix3fv(glGetUniformLocation(m_programHandle, name.c_str()), 1, GL_FALSE, glm::value_ptr(value));
+        glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(value));
+        RenderState::CountUniformUpload();
       }
 
-      void Uniform(const std::string &name, glm::vec2 value) {
+      void Uniform(GLint location, glm::vec2 value) {
         Use();
-        glUniform2fv(glGetUniformLocation(m_programHandle, name.c_str()), 1, glm::value_ptr(value));
+        glUniform2fv(location, 1, glm::value_ptr(value));
+        RenderState::CountUniformUpload();
       }
 
-      void Uniform(const std::string &name, glm::vec3 value) {
+      void Uniform(GLint location, glm::vec3 value) {
         Use();
-        glUniform3fv(glGetUniformLocation(m_programHandle, name.c_str()), 1, glm::value_ptr(value));
+        glUniform3fv(location, 1, glm::value_ptr(value));
+        RenderState::CountUniformUpload();
       }
 
-      void Uniform(const std::string &name, glm::vec4 value) {
+      void Uniform(GLint location, glm::vec4 value) {
         Use();
-        glUniform4fv(glGetUniformLocation(m_programHandle, name.c_str()), 1, glm::value_ptr(value));
+        glUniform4fv(location, 1, glm::value_ptr(value));
+        RenderState::CountUniformUpload();
       }
     private:
       GLuint m_programHandle;
       GLuint m_vertexHandle, m_fragmentHandle;
 
+      // every active uniform, resolved once after linking
+      std::unordered_map<std::string, GLint> m_uniformLocations;
+
       [[nodiscard]] auto ReadFile(const std::string &path) const -> std::string;
       [[nodiscard]] auto Compile(const char *source, GLenum type, const std::string_view filename) const -> GLuint;
       [[nodiscard]] auto Link() const -> GLuint;
+      void ReflectUniforms();
     };
 
   }
@@ -0,0 +1,61 @@
+#ifndef STREAM_BUFFER_H_
+#define STREAM_BUFFER_H_
+
+#include "Graphics/BufferObject.h"
+#include "Graphics/gfx.h"
+#include "Utils/NonCopyable.h"
+#include <cstdint>
+#include <deque>
+
+namespace TinyMinecraft {
+
+  namespace Graphics {
+
+    // Ring buffer for data written by the CPU every frame. With ARB_buffer_storage it is mapped once,
+    // persistently, and fences keep the CPU from overwriting a range the GPU has not read yet. Otherwise each
+    // range is mapped unsynchronized and the buffer is orphaned whenever the ring wraps.
+    class StreamBuffer : private Utils::NonCopyable {
+    public:
+      StreamBuffer(GLenum target, GLsizeiptr capacity);
+      ~StreamBuffer();
+
+      // Reserves `size` bytes, at most the capacity, at an offset that is a multiple of `alignment` and returns
+      // where to write them. Binds the buffer. Commands reading the range must be issued before the next Map.
+      [[nodiscard]] auto Map(GLsizeiptr size, GLsizeiptr alignment = 4) -> void *;
+      void Unmap();
+
+      // offset of the range returned by the last Map
+      [[nodiscard]] inline auto GetMappedOffset() const -> GLintptr { return m_mappedOffset; }
+      [[nodiscard]] inline auto GetCapacity() const -> GLsizeiptr { return m_capacity; }
+
+      inline void Bind() const { m_buffer.Bind(); }
+      [[nodiscard]] inline auto GetHandle() const -> GLuint { return m_buffer.GetHandle(); }
+      [[nodiscard]] inline auto IsPersistent() const -> bool { return m_persistentData != nullptr; }
+
+    private:
+      // GPU commands issued before the fence have consumed every byte written before `position`
+      struct Fence {
+        GLsync sync;
+        uint64_t position;
+      };
+
+      BufferObject m_buffer;
+      GLenum m_target;
+      GLsizeiptr m_capacity;
+
+      // total bytes reserved so far; the ring offset is the position modulo the capacity
+      uint64_t m_position = 0;
+      uint64_t m_fencedPosition = 0;
+      GLintptr m_mappedOffset = 0;
+
+      uint8_t *m_persistentData = nullptr;
+      std::deque<Fence> m_fences;
+
+      void WaitForRange(uint64_t end);
+    };
+
+  }
+
+}
+
+#endif // STREAM_BUFFER_H_
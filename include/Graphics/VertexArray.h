@@ -1,6 +1,7 @@
 #ifndef VERTEX_ARRAY_H_
 #define VERTEX_ARRAY_H_
 
+#include "Graphics/RenderState.h"
 #include "Graphics/gfx.h"
 #include "Utils/NonMovable.h"
 
@@ -17,8 +18,8 @@ namespace TinyMinecraft {
       auto operator=(VertexArray &&other) noexcept -> VertexArray &;
 
       void AddAttribute(GLuint id, int attributeSize, GLenum attributeType, int stride, int offset);
-      inline void Bind() const { glBindVertexArray(m_handle); }
-      inline void Unbind() const { glBindVertexArray(0); };
+      inline void Bind() const { RenderState::BindVertexArray(m_handle); }
+      inline void Unbind() const { RenderState::BindVertexArray(0); };
     private:
       GLuint m_handle;
     };
@@ -16,8 +16,10 @@ namespace TinyMinecraft {
       virtual void OnPlayerMove(const Event::PlayerMovedEvent &event) = 0;
 
       [[nodiscard]] inline auto GetViewProjection() const -> glm::mat4 { return m_viewProjection; }
+      [[nodiscard]] inline auto GetPosition() const -> glm::vec3 { return m_position; }
     protected:
       glm::mat4 m_viewProjection;
+      glm::vec3 m_position { 0.0f };
     };
 
     class FirstPersonPlayerCamera : public PlayerCamera {
@@ -44,7 +46,6 @@ namespace TinyMinecraft {
       glm::vec3 m_up { 0.0f, 1.0f, 0.0f };
       glm::vec3 m_front { 0.0f, 0.0f, -1.0f };
       glm::vec3 m_right { 1.0f, 0.0f, 0.0f };
-      glm::vec3 m_position { 0.0f };
 
       float m_fov { 45.0f };
       float m_aspect { 1.6f };
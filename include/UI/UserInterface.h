@@ -1,7 +1,9 @@
 #ifndef USER_INTERFACE_H_
 #define USER_INTERFACE_H_
 
+#include "Utils/MemoryTracker.h"
 #include "World/Biome.h"
+#include "World/ChunkLifecycle.h"
 #include "World/World.h"
 
 namespace TinyMinecraft {
@@ -19,6 +21,12 @@ namespace TinyMinecraft {
       void SetCurrentFPS(int fps);
       void SetPlayerPosition(const glm::vec3 &pos);
       void SetChunkPosition(const glm::ivec2 &pos);
+      void SetChunkCounts(size_t drawn, size_t culled, size_t occluded, size_t hidden, float culledSectionFraction);
+      void SetMeshUploads(size_t pending, size_t uploadedBytes);
+      void SetGLCalls(int calls, int drawCalls, int skippedStateChanges);
+      void SetChunkLifecycle(const World::ChunkLifecycleStats &stats);
+      void SetFrameAllocations(uint64_t count, uint64_t bytes);
+      void SetMemoryStats(const Utils::MemoryStats &stats);
       void SetDebugValues(float temperature, float humidity, float continentalness, float erosion, float ridges, World::BiomeType biome, World::BlockLocation targetBlock);
     private:
       size_t m_basicVertexCount = 0, m_textVertexCount = 0;
@@ -27,6 +35,13 @@ namespace TinyMinecraft {
       int m_currentFPS = 0;
       glm::vec3 m_playerPosition { 0.f };
       glm::ivec2 m_chunkPosition { 0 };
+      size_t m_drawnChunks = 0, m_culledChunks = 0, m_occludedChunks = 0, m_hiddenChunks = 0;
+      float m_culledSectionFraction = 0.0f;
+      size_t m_pendingMeshes = 0, m_uploadedBytes = 0;
+      int m_glCalls = 0, m_drawCalls = 0, m_skippedStateChanges = 0;
+      World::ChunkLifecycleStats m_chunkLifecycle;
+      uint64_t m_frameAllocations = 0, m_frameAllocatedBytes = 0;
+      Utils::MemoryStats m_memory;
 
       static constexpr int viewportWidth = 1920;
       static constexpr int viewportHeight = 1080;
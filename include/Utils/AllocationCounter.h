@@ -0,0 +1,33 @@
+#ifndef ALLOCATION_COUNTER_H_
+#define ALLOCATION_COUNTER_H_
+
+#include "Utils/defs.h"
+#include <cstdint>
+
+namespace TinyMinecraft {
+
+  namespace Utils {
+
+    struct AllocationCount {
+      uint64_t count;
+      uint64_t bytes;
+
+      [[nodiscard]] auto operator-(const AllocationCount &other) const -> AllocationCount {
+        return AllocationCount{ count - other.count, bytes - other.bytes };
+      }
+    };
+
+    // Counts the calls to the global operator new of each thread, with UTILS_CountAllocations. The difference of two
+    // reads on one thread is what ran in between allocated, which is how profiled scopes, frames and chunk tasks are
+    // charged for their allocations.
+    class AllocationCounter {
+    public:
+      // since the calling thread started, zero without UTILS_CountAllocations
+      [[nodiscard]] static auto GetThreadCount() -> AllocationCount;
+    };
+
+  }
+
+}
+
+#endif // ALLOCATION_COUNTER_H_
@@ -0,0 +1,65 @@
+#ifndef LATENCY_HISTOGRAM_H_
+#define LATENCY_HISTOGRAM_H_
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+
+namespace TinyMinecraft {
+
+  namespace Utils {
+
+    // Log-bucketed histogram in the style of HdrHistogram: values below 64 are counted exactly, every power of two
+    // above is split into 32 buckets, so any percentile is within about 3% of the true value in constant memory.
+    class LatencyHistogram {
+    public:
+      void Record(uint64_t value) {
+        ++m_buckets[GetBucketIndex(value)];
+        ++m_count;
+        m_max = std::max(m_max, value);
+      }
+
+      void Reset() {
+        m_buckets.fill(0);
+        m_count = 0;
+        m_max = 0;
+      }
+
+      // highest value of the bucket holding the percentile, at most the largest value recorded
+      [[nodiscard]] auto GetPercentile(double percentile) const -> uint64_t;
+
+      [[nodiscard]] inline auto GetCount() const -> uint64_t { return m_count; }
+      [[nodiscard]] inline auto GetMax() const -> uint64_t { return m_max; }
+
+    private:
+      static constexpr int SUB_BUCKET_BITS = 5;
+      static constexpr uint64_t SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+      static constexpr uint64_t LINEAR_COUNT = 2 * SUB_BUCKET_COUNT;
+      // up to 2^40, 18 minutes in nanoseconds; larger values share the last bucket
+      static constexpr int MAX_VALUE_BITS = 40;
+      static constexpr size_t BUCKET_COUNT = LINEAR_COUNT + (MAX_VALUE_BITS - SUB_BUCKET_BITS - 1) * SUB_BUCKET_COUNT;
+
+      std::array<uint64_t, BUCKET_COUNT> m_buckets {};
+      uint64_t m_count = 0;
+      uint64_t m_max = 0;
+
+      [[nodiscard]] static inline auto GetBucketIndex(uint64_t value) -> size_t {
+        if (value < LINEAR_COUNT) {
+          return static_cast<size_t>(value);
+        }
+
+        // the top SUB_BUCKET_BITS + 1 bits select the bucket
+        const int shift = std::bit_width(value) - SUB_BUCKET_BITS - 1;
+        const size_t index = LINEAR_COUNT + (shift - 1) * SUB_BUCKET_COUNT + ((value >> shift) - SUB_BUCKET_COUNT);
+        return std::min(index, BUCKET_COUNT - 1);
+      }
+
+      [[nodiscard]] static auto GetBucketUpperBound(size_t index) -> uint64_t;
+    };
+
+  }
+
+}
+
+#endif // LATENCY_HISTOGRAM_H_
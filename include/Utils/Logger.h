@@ -1,10 +1,15 @@
 #ifndef LOGGER_H_
 #define LOGGER_H_
 
+#include <array>
+#include <charconv>
 #include <cstdint>
 #include <functional>
+#include <ostream>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <system_error>
 #include <type_traits>
 #include "Utils/Printable.h"
 #include "Utils/Singleton.h"
@@ -16,6 +21,9 @@ namespace TinyMinecraft {
 
     using LoggerFn = std::function<void(const std::string &)>;
 
+    // Formats on the calling thread into a reused buffer, then hands the line to a per-thread lock-free queue that
+    // a background writer thread empties, so logging never waits on the output. Errors and fatals wait until they
+    // are written, as the callers usually exit right after.
     class Logger : private Singleton {
     public:
       enum class Level : uint8_t {
@@ -27,49 +35,64 @@ namespace TinyMinecraft {
         Fatal
       };
 
+      // called on the writer thread with every line, color and newline included
       static void SetOutputCallback(LoggerFn func);
 
+      // "{}" is replaced by the next argument; placeholders without one stay, arguments without one are dropped
       template<typename... Args>
-      static void Log(Level level, const std::string &format, Args... args) {
-        std::ostringstream oss;
+      static void Log(Level level, std::string_view format, const Args &...args) {
+        std::string &line = GetLineBuffer();
+        line.clear();
 
-        if constexpr (sizeof...(args) > 0) FormatString(oss, format, args...);
-        else oss << format;
+        line.append(GetColor(level));
+        line.append("[ ");
+        line.append(LevelToString(level));
+        line.append(" (");
+        line.append(Utils::GetThreadName());
+        line.append(") ] ");
 
-        std::string color = GetColor(level);
-        std::string levelStr = LevelToString(level);
+        size_t position = 0;
+        (AppendArgument(line, format, position, args), ...);
+        line.append(format.substr(position));
 
-        std::ostringstream out;
-        out << color << "[ " << levelStr << " (" << Utils::GetThreadName() << ") ] " << oss.str() << RESET << "\n";
+        line.append(RESET);
+        line.push_back('\n');
 
-        GetOutputCallback()(out.str());
+        Enqueue(line);
+
+        if (level >= Level::Error) {
+          Flush();
+        }
       }
 
       template<typename... Args>
-      static void Message(const std::string &format, Args... args) {
+      static void Message(std::string_view format, const Args &...args) {
         Log(Level::Message, format, args...);
       }
 
       template<typename... Args>
-      static void Debug(const std::string &format, Args... args) {
+      static void Debug(std::string_view format, const Args &...args) {
         Log(Level::Debug, format, args...);
       }
 
       template<typename... Args>
-      static void Warning(const std::string &format, Args... args) {
+      static void Warning(std::string_view format, const Args &...args) {
         Log(Level::Warning, format, args...);
       }
 
       template<typename... Args>
-      static void Error(const std::string &format, Args... args) {
+      static void Error(std::string_view format, const Args &...args) {
         Log(Level::Error, format, args...);
       }
 
       template<typename... Args>
-      static void Fatal(const std::string &format, Args... args) {
+      static void Fatal(std::string_view format, const Args &...args) {
         Log(Level::Fatal, format, args...);
       }
 
+      // waits until everything logged so far is written
+      static void Flush();
+
     private:
       static constexpr const char* RESET = "\033[0m";
       static constexpr const char* YELLOW = "\033[33m";
@@ -78,40 +101,56 @@ namespace TinyMinecraft {
       static constexpr const char* BLUE = "\033[34m";
 
       static auto GetOutputCallback() -> LoggerFn &;
-      static auto GetColor(Level level) -> std::string;
-      static auto LevelToString(Level level) -> std::string;
+      static auto GetColor(Level level) -> const char *;
+      static auto LevelToString(Level level) -> const char *;
+
+      // per thread, keeps its capacity between messages
+      static auto GetLineBuffer() -> std::string &;
+      static void Enqueue(std::string_view line);
+      // appends to `line`, with default formatting, for the types only operator<< knows
+      static auto GetLineStream(std::string &line) -> std::ostream &;
+
+      static void RunWriterThread();
+      // returns whether anything was queued
+      static auto WriteQueued() -> bool;
 
       template<typename T>
-      static void FormatString(std::ostringstream &oss, const std::string &format, const T &value) {
-        size_t placeholderPos = format.find("{}");
-        if (placeholderPos != std::string::npos) {
-          oss << format.substr(0, placeholderPos) << ToString(value) << format.substr(placeholderPos + 2);
-        } else {
-          oss << format;
+      static void AppendArgument(std::string &line, std::string_view format, size_t &position, const T &value) {
+        const size_t placeholder = format.find("{}", position);
+        if (placeholder == std::string_view::npos) {
+          return;
         }
-      }
 
-      template<typename T, typename... Args>
-      static void FormatString(std::ostringstream &oss, const std::string& format, const T& value, Args... args) {
-        size_t placeholderPos = format.find("{}");
-        if (placeholderPos != std::string::npos) {
-          oss << format.substr(0, placeholderPos) << ToString(value);
-          FormatString(oss, format.substr(placeholderPos + 2), args...);
-        } else {
-          oss << format;
-        }
+        line.append(format.substr(position, placeholder - position));
+        AppendValue(line, value);
+        position = placeholder + 2;
       }
 
+      // like std::to_string for numbers, and operator<< for everything else that is not Printable
       template<typename T>
-      static std::string ToString(const T &value) {
-        if constexpr (std::is_arithmetic_v<T>) {
-          return std::to_string(value);
+      static void AppendValue(std::string &line, const T &value) {
+        if constexpr (std::is_same_v<T, bool>) {
+          line.push_back(value ? '1' : '0');
+        } else if constexpr (std::is_arithmetic_v<T>) {
+          std::array<char, 64> buffer;
+          std::to_chars_result result;
+          if constexpr (std::is_floating_point_v<T>) {
+            result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value, std::chars_format::fixed, 6);
+          } else {
+            result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+          }
+
+          if (result.ec == std::errc()) {
+            line.append(buffer.data(), result.ptr);
+          } else {
+            line.append(std::to_string(value));
+          }
         } else if constexpr (std::is_base_of_v<Printable, T>) {
-          return value.ToString();
+          line.append(value.ToString());
+        } else if constexpr (std::is_convertible_v<const T &, std::string_view>) {
+          line.append(std::string_view(value));
         } else {
-          std::ostringstream oss;
-          oss << value;
-          return oss.str();
+          GetLineStream(line) << value;
         }
       }
     };
@@ -0,0 +1,76 @@
+#ifndef MEMORY_TRACKER_H_
+#define MEMORY_TRACKER_H_
+
+#include "Utils/NonCopyable.h"
+#include "Utils/NonMovable.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace TinyMinecraft {
+
+  namespace Utils {
+
+    enum class MemoryCategory : uint8_t {
+      ChunkBlocks = 0,    // block arrays of generated chunks
+      MeshStaging,        // chunk meshes on the CPU, from meshing until uploaded, and translucent faces kept for sorting
+      GpuBuffers,         // storage of every BufferObject
+      WorldGenScratch,    // noise grids of the generation tasks running
+      Profiler,           // thread buffers, sections and captured trace events
+    };
+
+    constexpr size_t MEMORY_CATEGORY_COUNT = 5;
+
+    // bytes
+    struct MemoryCategoryStats {
+      int64_t current = 0, peak = 0;
+      int64_t budget = 0;   // 0 for none
+    };
+
+    struct MemoryStats {
+      std::array<MemoryCategoryStats, MEMORY_CATEGORY_COUNT> categories;
+      long long residentBytes = 0;
+    };
+
+    // Live bytes of each subsystem, counted where they allocate what dominates their footprint. Cheaper and more
+    // telling than the resident size of the process, which includes the allocator and driver and rarely shrinks.
+    class MemoryTracker {
+    public:
+      static void Add(MemoryCategory category, int64_t bytes);
+      static inline void Release(MemoryCategory category, int64_t bytes) { Add(category, -bytes); }
+
+      [[nodiscard]] static auto GetStats() -> MemoryStats;
+      [[nodiscard]] static auto GetCategoryName(MemoryCategory category) -> const char *;
+      [[nodiscard]] static auto GetBudget(MemoryCategory category) -> int64_t;
+
+      // of the whole process right now, 0 where unsupported
+      [[nodiscard]] static auto GetResidentBytes() -> long long;
+
+      // warns about every category that went over its UTILS_MEMORY_BUDGET_ since the last check, once until it
+      // comes back under
+      static void CheckBudgets();
+      static void LogSummary();
+    };
+
+    // counts `bytes` of a category for as long as it lives, for scratch memory of a scope
+    class TrackedMemory : private NonCopyable, private NonMoveable {
+    public:
+      TrackedMemory(MemoryCategory category, int64_t bytes)
+        : m_category(category)
+        , m_bytes(bytes)
+      {
+        MemoryTracker::Add(m_category, m_bytes);
+      }
+
+      ~TrackedMemory() { MemoryTracker::Release(m_category, m_bytes); }
+
+    private:
+      MemoryCategory m_category;
+      int64_t m_bytes;
+    };
+
+  }
+
+}
+
+#endif // MEMORY_TRACKER_H_
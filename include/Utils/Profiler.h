@@ -1,21 +1,16 @@
 #ifndef PROFILER
 #define PROFILER
 
+#include "Utils/AllocationCounter.h"
 #include "Utils/NonCopyable.h"
 #include "Utils/NonMovable.h"
-#include "Utils/Singleton.h"
+#include "Utils/defs.h"
 #include <chrono>
-#include <mutex>
+#include <cstdint>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <vector>
 
-#ifdef __APPLE__
-  #include <mach/mach.h>
-#elif defined(__linux__)
-  #include <sys/resource.h>
-#endif
-
 namespace TinyMinecraft {
 
   namespace Utils {
@@ -30,30 +25,77 @@ namespace TinyMinecraft {
       Game,
     };
 
-    struct ProfileData {
-      long long duration;    // nanoseconds
-      long long memoryDiff;  // bytes
+    struct ProfileRecord;
+
+    // durations in nanoseconds, percentiles within about 3%
+    struct ProfileSectionStats {
+      std::string name;
+      ProfileCategory category;
+      uint64_t count;
+      long long totalTime;
+      long long p50, p90, p99, p999, max;
+      long long totalMemoryDiff;   // bytes, with UTILS_ProfileMemory
+      uint64_t totalAllocations, totalAllocatedBytes;   // by the scope and the ones it called, with UTILS_CountAllocations
     };
 
+    // Times a scope. Closed scopes are written to a lock-free ring buffer of the thread that ran them, and a
+    // background thread merges the buffers into per-section totals, so profiling neither takes a lock nor allocates.
     class Profiler : private NonCopyable, private NonMoveable {
     public:
-      Profiler(std::string_view section, ProfileCategory category = ProfileCategory::Miscellaneous);
+      explicit Profiler(uint32_t sectionId)
+        : m_sectionId(sectionId)
+#ifdef UTILS_ProfileMemory
+        , m_memoryStart(GetCurrentMemoryUsage())
+#endif
+#ifdef UTILS_CountAllocations
+        , m_allocationsStart(AllocationCounter::GetThreadCount())
+#endif
+        , m_start(GetTimestamp())
+      {}
+
       ~Profiler();
 
-      static void LogSummary();
+      // interns the name of a section, once per call site through the PROFILE_ macros
+      [[nodiscard]] static auto RegisterSection(std::string_view name, ProfileCategory category = ProfileCategory::Miscellaneous) -> uint32_t;
+
+      // Sections run since the start or the last reset. Resetting starts the next phase from empty histograms, to
+      // measure one part of a session like a fast flight on its own
+      [[nodiscard]] static auto Snapshot(bool reset = false) -> std::vector<ProfileSectionStats>;
+      static void LogSummary(bool reset = false);
+
+      // Records a timeline of every thread for `seconds` or until EndCapture, with the frames and counters, and
+      // writes it as a Chrome trace to ../traces
+      static void BeginCapture(float seconds = UTILS_TRACE_SECONDS);
+      static void EndCapture();
+      [[nodiscard]] static auto IsCapturing() -> bool;
+
+      // only recorded while capturing
+      static void MarkFrame();
+      static void RecordCounter(uint32_t counterId, long long value);
 
     private:
-      ProfileCategory m_category;
-      std::string m_name;
-      std::chrono::time_point<std::chrono::high_resolution_clock> m_start;
+      uint32_t m_sectionId;
+#ifdef UTILS_ProfileMemory
       long long m_memoryStart;
+#endif
+#ifdef UTILS_CountAllocations
+      AllocationCount m_allocationsStart;
+#endif
+      uint64_t m_start;
+
+      // nanoseconds
+      [[nodiscard]] static inline auto GetTimestamp() -> uint64_t {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+      }
 
-      static std::unordered_map<ProfileCategory, std::unordered_map<std::string, std::vector<ProfileData>>> records;
-      static std::mutex recordMutex;
+      [[nodiscard]] static auto GetCurrentMemoryUsage() -> long long;
 
-      static auto GetCurrentMemoryUsage() -> size_t;
+      static void PushRecord(const ProfileRecord &record);
 
-      void LogRecord(ProfileCategory cat, const std::string &section, long long duration, long long memDiff);
+      static void RunAggregatorThread();
+      static void Aggregate();
+      // with the aggregate mutex held
+      static void DrainBuffers();
 
       static auto CategoryToString(ProfileCategory category) -> std::string;
 
@@ -74,15 +116,25 @@ namespace TinyMinecraft {
 #define VARNAME(Var) CAT(Var, __LINE__)
 
 #ifdef UTILS_RunProfile
-  #define PROFILE_FUNCTION_Misc() TinyMinecraft::Utils::Profiler VARNAME(timer) {__FUNCTION__};
-  #define PROFILE_SCOPE_Misc(name) TinyMinecraft::Utils::Profiler VARNAME(timer) {name};
-  #define PROFILE_FUNCTION(category) TinyMinecraft::Utils::Profiler VARNAME(timer) {__FUNCTION__, Utils::ProfileCategory::category};
-  #define PROFILE_SCOPE(category, name) TinyMinecraft::Utils::Profiler VARNAME(timer) {name, Utils::ProfileCategory::category};
+  #define PROFILE_SCOPE(category, name) \
+    static const uint32_t VARNAME(profileSection) = TinyMinecraft::Utils::Profiler::RegisterSection(name, TinyMinecraft::Utils::ProfileCategory::category); \
+    TinyMinecraft::Utils::Profiler VARNAME(timer) {VARNAME(profileSection)};
+  #define PROFILE_FUNCTION(category) PROFILE_SCOPE(category, __FUNCTION__)
+  #define PROFILE_SCOPE_Misc(name) PROFILE_SCOPE(Miscellaneous, name)
+  #define PROFILE_FUNCTION_Misc() PROFILE_SCOPE(Miscellaneous, __FUNCTION__)
+  #define PROFILE_FRAME() TinyMinecraft::Utils::Profiler::MarkFrame();
+  #define PROFILE_COUNTER(name, value) \
+    if (TinyMinecraft::Utils::Profiler::IsCapturing()) { \
+      static const uint32_t VARNAME(profileCounter) = TinyMinecraft::Utils::Profiler::RegisterSection(name); \
+      TinyMinecraft::Utils::Profiler::RecordCounter(VARNAME(profileCounter), static_cast<long long>(value)); \
+    }
 #else
   #define PROFILE_FUNCTION_Misc() do{} while(0);
   #define PROFILE_SCOPE_Misc(name) do{} while(0);
   #define PROFILE_FUNCTION(category) do{} while(0);
   #define PROFILE_SCOPE(category, name) do{} while(0);
+  #define PROFILE_FRAME() do{} while(0);
+  #define PROFILE_COUNTER(name, value) do{} while(0);
 #endif
 
 #endif // PROFILER
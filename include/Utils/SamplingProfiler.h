@@ -0,0 +1,27 @@
+#ifndef SAMPLING_PROFILER_H_
+#define SAMPLING_PROFILER_H_
+
+#include "Utils/defs.h"
+
+namespace TinyMinecraft {
+
+  namespace Utils {
+
+    // Samples the call stacks of every thread at a fixed rate of CPU time, so it also sees what no PROFILE_ macro
+    // covers. Uses perf_event_open and falls back to SIGPROF where perf events are not allowed; Linux only.
+    // Stacks are written folded, "thread;outer;...;inner count" per line, for flamegraph.pl or speedscope.
+    class SamplingProfiler {
+    public:
+      // returns whether sampling started
+      static auto Start(int frequency = UTILS_SAMPLING_FREQUENCY) -> bool;
+      // stops and writes the stacks to ../traces
+      static void Stop();
+
+      [[nodiscard]] static auto IsRunning() -> bool;
+    };
+
+  }
+
+}
+
+#endif // SAMPLING_PROFILER_H_
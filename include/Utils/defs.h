@@ -8,8 +8,27 @@
 // Shadow mapping (BROKEN!)
   // #define GFX_ShadowMapping
 
+// Skips chunks whose sections cannot be seen through the cave connectivity graph
+  #define GFX_SectionOcclusionCulling
+
+// Tests the remaining sections against a software depth buffer of the nearest fully solid sections
+  #define GFX_DepthOcclusionCulling
+
+// Meshes distant chunks from 2x2x2 or 4x4x4 merged blocks, see GFX_LOD_*_DISTANCE
+  #define GFX_MeshLOD
+
+// Draws a coarse heightfield of the terrain beyond the chunks, out to GFX_FAR_DISTANCE (World::FarTerrain)
+  #define GFX_FarTerrain
+
+// Counts the draws, uploads and state changes reaching the driver every frame (Graphics::Device)
+  // #define GFX_RecordDevice
+
 // Values
   #define GFX_RENDER_DISTANCE 16
+  #define GFX_UPLOAD_BUDGET_BYTES (4 * 1024 * 1024)   // mesh data uploaded per frame, at least one mesh
+  #define GFX_LOD_2X_DISTANCE 8    // chunks at least this far from the player are meshed at half resolution
+  #define GFX_LOD_4X_DISTANCE 12   // and at a quarter from here on
+  #define GFX_FAR_DISTANCE 96      // chunks, end of the far terrain
 
 // text
 #define TEXT_CHAR_WIDTH 12
@@ -24,6 +43,8 @@
 #define CHUNK_WIDTH 16
 #define CHUNK_HEIGHT 256
 #define CHUNK_LENGTH 16
+#define CHUNK_SECTION_HEIGHT 16
+#define CHUNK_SECTION_COUNT (CHUNK_HEIGHT / CHUNK_SECTION_HEIGHT)
 
 #define FIXED_UPDATE_INTERVAL (1000.0f / 60.0f)
 
@@ -31,6 +52,19 @@
   #define UTILS_ShowFPS
   #define UTILS_RunProfile
   // #define UTILS_ProfileVerbose    // Will print profile data on every run
+  #define UTILS_TRACE_SECONDS 10.0f           // longest timeline capture (F7, --trace)
+  #define UTILS_TRACE_MAX_EVENTS (1 << 21)    // and its most events, about 80 MB
+  #define UTILS_SAMPLING_FREQUENCY 999        // stack samples per second of CPU time of each thread (F9, --sample)
+  #define UTILS_ChunkLifecycle           // Times every chunk state transition and first draw (World::ChunkLifecycle)
+  // #define UTILS_CountAllocations  // Counts operator new per thread, charged to profiled scopes, frames and chunk tasks
+  // #define UTILS_FRAME_ALLOCATION_BUDGET 0     // with it, warns about frames allocating more than this on the main thread
+  #define UTILS_MEMORY_BUDGET_CHUNK_BLOCKS (384ll << 20)     // bytes of each Utils::MemoryCategory, warned about
+  #define UTILS_MEMORY_BUDGET_MESH_STAGING (128ll << 20)     // once when exceeded, 0 for none
+  #define UTILS_MEMORY_BUDGET_GPU_BUFFERS (512ll << 20)
+  #define UTILS_MEMORY_BUDGET_WORLDGEN_SCRATCH (32ll << 20)
+  #define UTILS_MEMORY_BUDGET_PROFILER (128ll << 20)
+  // #define UTILS_ProfileMemory     // Samples the resident memory at both ends of every profiled scope, a file read each
+  // #define WORLDGEN_NaiveSurfaceRules   // Decorates surfaces with per-block Biome::GenerateBlock calls instead of span fills
 
 #define GAMEPLAY_MaxBlockInteractDistance (5.0f)
 
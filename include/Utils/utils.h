@@ -2,6 +2,8 @@
 #define UTILS_H_
 
 #include <array>
+#include <optional>
+#include <string>
 #include <Utils/mathgl.h>
 #ifdef _WIN32
   #include <windows.h>
@@ -11,6 +13,12 @@ namespace TinyMinecraft {
 
   namespace Utils {
 
+    // the name of the calling thread, set by SetThreadName or read from the OS on first use
+    [[nodiscard]] auto inline GetThreadNameCache() -> std::optional<std::string> & {
+      static thread_local std::optional<std::string> name;
+      return name;
+    }
+
     void inline SetThreadName(const std::string &name) {
 #ifdef __APPLE__
       pthread_setname_np(name.c_str());
@@ -20,27 +28,34 @@ namespace TinyMinecraft {
       std::wstring wname(name.begin(), name.end());
       SetThreadDescription(GetCurrentThread(), wname.c_str());
 #endif
+      GetThreadNameCache() = name;
     }
 
-    auto inline GetThreadName() -> std::string {
+    // cached, as the logger asks for it on every message
+    auto inline GetThreadName() -> const std::string & {
+      std::optional<std::string> &cache = GetThreadNameCache();
+      if (cache) {
+        return *cache;
+      }
+
 #if defined(__APPLE__) || defined(__linux__)
       char name[16] = {0};
       int err = pthread_getname_np(pthread_self(), name, sizeof(name));
-      if (err != 0) {
-        return std::string();
-      }
-      return std::string(name);
+      cache = err == 0 ? std::string(name) : std::string();
 #elif defined(_WIN32)
       PWSTR threadDesc = nullptr;
       HRESULT hr = GetThreadDescription(GetCurrentThread(), &threadDesc);
       if (SUCCEEDED(hr) && threadDesc != nullptr) {
         std::wstring wname(threadDesc);
-        std::string name(wname.begin(), wname.end());
+        cache = std::string(wname.begin(), wname.end());
         LocalFree(threadDesc);
-        return name;
+      } else {
+        cache = std::string();
       }
-      return "";
+#else
+      cache = std::string();
 #endif
+      return *cache;
     }
 
     // Linearly scales a value from starting range to end range
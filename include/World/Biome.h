@@ -2,6 +2,8 @@
 #define BIOME_H_
 
 #include "World/BlockType.h"
+#include <array>
+#include <cstdint>
 #include <string>
 
 namespace TinyMinecraft {
@@ -19,6 +21,30 @@ namespace TinyMinecraft {
       Desert
     };
 
+    // `depth` blocks of `block`, stacked downward from the surface of a column
+    struct SurfaceLayer {
+      BlockType block = BlockType::Air;
+      int depth = 0;
+    };
+
+    // Surface rules of `Biome::GenerateBlock` flattened into per-column span fills: "top N blocks
+    // are X, next M are Y", with stone everywhere below.
+    struct SurfaceRules {
+      static constexpr int MAX_LAYERS = 2;
+
+      std::array<SurfaceLayer, MAX_LAYERS> layers {};
+      int layerCount = 0;
+
+      BlockType shoreBlock = BlockType::Air;  // replaces the top block when the surface is at or below sea level
+      bool hasStoneOutcrops = false;          // columns whose stone noise passes the threshold stay bare stone
+
+      [[nodiscard]] inline auto GetTotalDepth() const -> int {
+        int depth = 0;
+        for (int i = 0; i < layerCount; ++i) depth += layers[i].depth;
+        return depth;
+      }
+    };
+
     class Biome {
     public:
       Biome(BiomeType type, float minHeight, float maxHeight, 
@@ -27,6 +53,7 @@ namespace TinyMinecraft {
 
       [[nodiscard]] auto IsValid(double temperature, double humidity) const -> bool;
       [[nodiscard]] auto GenerateBlock(int x, int y, int z, int height, double stoneMap) const -> BlockType;
+      [[nodiscard]] inline auto GetSurfaceRules() const -> const SurfaceRules & { return m_surfaceRules; }
 
       [[nodiscard]] auto GetType() const -> BiomeType;
 
@@ -40,8 +67,12 @@ namespace TinyMinecraft {
       [[nodiscard]] auto GetMaxHumidty() const -> double;
 
       static auto GetBiomeName(BiomeType type) -> std::string;
+
+      static constexpr int SEA_LEVEL = 62;
+      static constexpr float STONE_THRESHOLD = 0.75f;
     private:
       BiomeType m_type;
+      SurfaceRules m_surfaceRules;
       
       double m_minHeight;
       double m_maxHeight;
@@ -51,6 +82,8 @@ namespace TinyMinecraft {
 
       double m_minHumidity;
       double m_maxHumidity;
+
+      [[nodiscard]] auto CompileSurfaceRules() const -> SurfaceRules;
     };
 
   }
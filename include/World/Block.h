@@ -31,6 +31,8 @@ namespace TinyMinecraft {
       [[nodiscard]] static inline auto IsSolid(BlockType block) -> bool { return data[block].isSolid; }
       [[nodiscard]] static inline auto IsEmpty(BlockType block) -> bool { return data[block].renderType == BlockRenderType::Empty; }
       [[nodiscard]] static inline auto IsTranslucent(BlockType block) -> bool { return data[block].isTranslucent; }
+      // returns false if no block has that name
+      [[nodiscard]] static auto FromName(const std::string &name, BlockType &block) -> bool;
     private:
       static std::unordered_map<BlockType, BlockDefinition> data;
       
@@ -1,19 +1,24 @@
 #ifndef CHUNK_H_
 #define CHUNK_H_
 
+#include <algorithm>
 #include <array>
 #include <vector>
 #include <memory>
 #include <atomic>
+#include <cstdint>
 
 #include "Geometry/Mesh.h"
 #include "Geometry/geometry.h"
+#include "Utils/MemoryTracker.h"
 #include "Utils/NonCopyable.h"
 #include "Utils/defs.h"
 #include "World/Block.h"
+#include "World/ChunkLifecycle.h"
 #include "Graphics/gfx.h"
 
-#define CHUNK_INDEX_AT(x, y, z) (CHUNK_LENGTH * CHUNK_HEIGHT * x + CHUNK_LENGTH * y + z)
+// columns are contiguous in y so that vertical spans can be filled in one write
+#define CHUNK_INDEX_AT(x, y, z) (CHUNK_LENGTH * CHUNK_HEIGHT * (x) + CHUNK_HEIGHT * (z) + (y))
 
 namespace TinyMinecraft {
 
@@ -21,15 +26,61 @@ namespace TinyMinecraft {
 
     class World;
 
+    // Generation runs in stages. A chunk only enters a stage once all of its neighbours have finished
+    // the previous one, so features can safely write across borders.
     enum class ChunkState : uint8_t {
       Empty = 0,
       Unloading,
-      Generating,
+      Generating,       // terrain and surface
+      TerrainGenerated,
+      Decorating,       // features; blocks outside the chunk are posted to neighbour inboxes
+      Decorated,
+      Finalizing,       // applies the blocks neighbours posted to this chunk
       Generated,
       Meshing,
       Loaded,
     };
 
+    // a block placed into a chunk by a feature of a neighbouring chunk, in local coordinates
+    struct FeatureBlock {
+      uint8_t x, y, z;
+      BlockType block;
+    };
+
+    struct FeatureBatch {
+      glm::ivec2 source;
+      std::vector<FeatureBlock> blocks;
+    };
+
+    // blocks a feature pass places outside its chunk, one batch per neighbour in a 3x3 grid (z-major)
+    using FeatureBatches = std::array<std::vector<FeatureBlock>, 9>;
+
+    [[nodiscard]] constexpr auto FeatureBatchIndex(int offsetX, int offsetZ) -> int {
+      return (offsetZ + 1) * 3 + (offsetX + 1);
+    }
+
+    // which faces of a CHUNK_SECTION_HEIGHT tall slice of a chunk can see each other through non-occluding
+    // cells, one bit per (Geometry::Face, Geometry::Face) pair at a * 6 + b
+    using SectionConnectivity = uint64_t;
+    constexpr SectionConnectivity SECTION_FULLY_CONNECTED = (1ull << 36) - 1;
+
+    [[nodiscard]] constexpr auto CanSeeThrough(SectionConnectivity connectivity, Geometry::Face from, Geometry::Face to) -> bool {
+      return (connectivity >> (from * 6 + to)) & 1;
+    }
+
+    // what culling needs to know of a chunk, as of one UpdateMesh
+    struct ChunkVisibility {
+      std::array<SectionConnectivity, CHUNK_SECTION_COUNT> connectivity = [] {
+        std::array<SectionConnectivity, CHUNK_SECTION_COUNT> fullyConnected;
+        fullyConnected.fill(SECTION_FULLY_CONNECTED);
+        return fullyConnected;
+      }();
+
+      // vertical extent of the non-empty blocks
+      int minHeight = 0, maxHeight = CHUNK_HEIGHT - 1;
+      bool hasTranslucentBlocks = false;
+    };
+
     // used for sorting purposes
     struct FaceGeometry {
       glm::vec3 pos;
@@ -38,26 +89,97 @@ namespace TinyMinecraft {
       float distanceToPlayer;
     };
 
+    // translucent faces of one UpdateMesh and the geometry they make, farthest from a player position first.
+    // Built by a worker, then owned by the main thread, which sorts it again as the player moves.
+    struct TranslucentGeometry {
+      std::vector<FaceGeometry> faces;
+      // emptied by the upload to the chunk's translucent mesh
+      std::vector<Geometry::MeshVertex> vertices;
+      std::vector<GLuint> indices;
+
+      TranslucentGeometry() = default;
+      TranslucentGeometry(const TranslucentGeometry &) = delete;
+      auto operator=(const TranslucentGeometry &) -> TranslucentGeometry & = delete;
+
+      ~TranslucentGeometry() { Utils::MemoryTracker::Release(Utils::MemoryCategory::MeshStaging, m_trackedBytes); }
+
+      // rebuilds the vertices and indices from the faces
+      void Sort(const glm::vec3 &playerPos);
+
+      // counts the faces as MemoryCategory::MeshStaging, once they are complete
+      void TrackMemory();
+
+    private:
+      int64_t m_trackedBytes = 0;
+    };
+
+    // geometry of one UpdateMesh, in chunk coordinates; not modified once handed to the renderer
+    struct ChunkMesh {
+      std::vector<Geometry::MeshVertex> vertices;
+      std::vector<GLuint> indices;
+      // null without translucent blocks; the renderer hands it to the chunk along with the upload
+      std::shared_ptr<TranslucentGeometry> translucent;
+      // the chunk's own fields are rewritten by its next UpdateMesh while other threads cull it, so they read this
+      ChunkVisibility visibility;
+
+      ChunkMesh() = default;
+      ChunkMesh(const ChunkMesh &) = delete;
+      auto operator=(const ChunkMesh &) -> ChunkMesh & = delete;
+
+      // until the renderer dropped it after the upload
+      ~ChunkMesh() { Utils::MemoryTracker::Release(Utils::MemoryCategory::MeshStaging, m_trackedBytes); }
+
+      [[nodiscard]] inline auto GetSizeInBytes() const -> size_t {
+        size_t bytes = vertices.size() * sizeof(Geometry::MeshVertex) + indices.size() * sizeof(GLuint);
+        if (translucent) {
+          bytes += translucent->vertices.size() * sizeof(Geometry::MeshVertex) + translucent->indices.size() * sizeof(GLuint);
+        }
+        return bytes;
+      }
+
+      // counts the storage as MemoryCategory::MeshStaging, once the geometry is complete
+      inline void TrackMemory() {
+        m_trackedBytes = static_cast<int64_t>(vertices.capacity() * sizeof(Geometry::MeshVertex) + indices.capacity() * sizeof(GLuint));
+        Utils::MemoryTracker::Add(Utils::MemoryCategory::MeshStaging, m_trackedBytes);
+      }
+
+    private:
+      int64_t m_trackedBytes = 0;
+    };
+
     class Chunk : public Utils::NonCopyable {
     public:
       Chunk(World &world, const glm::ivec2 &chunkPos);
-      ~Chunk() = default;
+      ~Chunk();
 
       Chunk(Chunk &&other) noexcept;
       auto operator=(Chunk &&other) noexcept -> Chunk &;
 
-      void UpdateMesh();
-      void BufferVertices();
+      // rebuilds the geometry into a new payload, so the renderer never reads what a worker is writing, with the
+      // translucent faces sorted from `playerPos`. Level n merges 2^n blocks per side into one cell; translucent
+      // geometry always has full detail.
+      auto UpdateMesh(int level = 0, const glm::vec3 &playerPos = glm::vec3(0.0f)) -> std::shared_ptr<const ChunkMesh>;
+
+      // from the main thread, which owns the translucent geometry once its mesh is uploaded
+      void SetTranslucentGeometry(std::shared_ptr<TranslucentGeometry> geometry);
       void BufferTranslucentVertices();
-      void UpdateTranslucentMesh(const glm::vec3 &playerPos);
       void SortTranslucentBlocks(const glm::vec3 &playerPos);
 
       inline void SetShouldClear(bool value) { m_shouldClear.store(value, std::memory_order_release); };
       [[nodiscard]] inline auto ShouldClear() -> bool { return m_shouldClear.load(std::memory_order_acquire); };
 
       void ClearBuffers();
-      inline void ReserveBlocks() { m_data.blocks.resize(m_data.BLOCK_COUNT, BlockType::Air); }
-      inline void ClearBlocks() { m_data.blocks.clear(); m_data.blocks.shrink_to_fit(); }
+      inline void ReserveBlocks() {
+        const int64_t bytes = GetBlockBytes();
+        m_data.blocks.resize(m_data.BLOCK_COUNT, BlockType::Air);
+        Utils::MemoryTracker::Add(Utils::MemoryCategory::ChunkBlocks, GetBlockBytes() - bytes);
+      }
+      inline void ClearBlocks() {
+        const int64_t bytes = GetBlockBytes();
+        m_data.blocks.clear();
+        m_data.blocks.shrink_to_fit();
+        Utils::MemoryTracker::Add(Utils::MemoryCategory::ChunkBlocks, GetBlockBytes() - bytes);
+      }
       [[nodiscard]] inline auto GetBlockAt(int x, int y, int z) -> BlockType {
         if (m_data.blocks.size() <= CHUNK_INDEX_AT(x, y, z)) {
           return BlockType::Air;
@@ -69,32 +191,84 @@ namespace TinyMinecraft {
         m_data.blocks.at(CHUNK_INDEX_AT(x, y, z)) = block;
       }
       inline void SetBlockAt(const glm::ivec3 &pos, BlockType block) { SetBlockAt(pos.x, pos.y, pos.z, block); }
+
+      // sets `count` blocks of column (x, z) starting at `y` and going up
+      inline void FillColumn(int x, int y, int z, int count, BlockType block) {
+        std::fill_n(m_data.blocks.begin() + CHUNK_INDEX_AT(x, y, z), count, block);
+      }
+
+      // like FillColumn, but only over the `target` blocks of the span, one fill for each run of them
+      inline void ReplaceInColumn(int x, int y, int z, int count, BlockType target, BlockType block) {
+        const auto end = m_data.blocks.begin() + CHUNK_INDEX_AT(x, y, z) + count;
+        for (auto it = end - count; it != end;) {
+          it = std::find(it, end, target);
+          const auto runEnd = std::find_if(it, end, [target](BlockType other) { return other != target; });
+          std::fill(it, runEnd, block);
+          it = runEnd;
+        }
+      }
+
+      // sets `count` blocks of row (y, z) starting at `x` and going east
+      inline void FillRow(int x, int y, int z, int count, BlockType block) {
+        for (int i = 0; i < count; ++i) {
+          m_data.blocks[CHUNK_INDEX_AT(x + i, y, z)] = block;
+        }
+      }
       
-      [[nodiscard]] auto GetSurfaceHeight(int x, int z) -> int;
+      // highest non-air block of the column once terrain is generated; features placed later are not tracked
+      [[nodiscard]] inline auto GetSurfaceHeight(int x, int z) const -> int { return m_data.heightmap[CHUNK_WIDTH * z + x]; }
+      inline void SetSurfaceHeight(int x, int z, int y) { m_data.heightmap[CHUNK_WIDTH * z + x] = static_cast<uint8_t>(y); }
+
+      // lock-free; may be called from any worker while this chunk is in any state. Replaces the batch the same
+      // neighbour posted before if it was not applied yet.
+      void PostFeatureBatch(std::unique_ptr<FeatureBatch> batch);
+      // only called while Finalizing
+      void ApplyFeatureBatches();
 
       [[nodiscard]] inline auto GetGlobalCoords(const glm::vec3 &pos) const -> glm::vec3 {
         return glm::vec3(m_chunkPos.x * CHUNK_WIDTH + pos.x, pos.y, m_chunkPos.y * CHUNK_LENGTH + pos.z);
       }
 
-      [[nodiscard]] inline auto GetMesh() const -> Geometry::Mesh & { return *m_opaqueMesh; }
-      [[nodiscard]] inline auto GetTranslucentMesh() const -> Geometry::Mesh & { return *m_translucentMesh; }
-      [[nodiscard]] inline auto HasTranslucentBlocks() const -> bool { return m_hasTranslucentBlocks; }
+      // created on first use so chunks can be generated without a GL context
+      [[nodiscard]] auto GetTranslucentMesh() -> Geometry::Mesh &;
+      [[nodiscard]] auto HashBlocks() const -> uint64_t;
       
+      // detail level of the last UpdateMesh
+      [[nodiscard]] inline auto GetMeshLevel() const -> int { return m_meshLevel; }
+
       [[nodiscard]] inline auto IsHidden() const -> bool { return m_hidden; }
       inline void SetHidden(bool value) { m_hidden = value; }
 
-      [[nodiscard]] inline auto IsDirty() const -> bool { return m_dirty.load(std::memory_order_acquire); }
-      inline void SetDirty(bool value) { m_dirty.store(value, std::memory_order_release); }
-
-      [[nodiscard]] inline auto IsTranslucentDirty() const -> bool { return m_translucentDirty.load(std::memory_order_acquire); }
-      inline void SetTranslucentDirty(bool value) { m_translucentDirty.store(value, std::memory_order_release); }
-
       [[nodiscard]] inline auto GetState() const -> ChunkState {
         return m_state.load(std::memory_order_acquire);
       }
 
       auto inline SetState(ChunkState expected, ChunkState desired) -> bool {
-        return m_state.compare_exchange_strong(expected, desired);
+        if (!m_state.compare_exchange_strong(expected, desired)) {
+          return false;
+        }
+
+#ifdef UTILS_ChunkLifecycle
+        RecordTransition(expected, desired);
+#endif
+        return true;
+      }
+
+      // the task of the current working state started on a worker
+      inline void BeginStageTask() {
+#ifdef UTILS_ChunkLifecycle
+        m_stageStartedAt.store(ChunkLifecycle::GetTimestamp(), std::memory_order_relaxed);
+#endif
+      }
+
+      // drawn in this frame, which only counts the first time since the chunk was requested
+      inline void MarkDrawn() {
+#ifdef UTILS_ChunkLifecycle
+        if (!m_wasDrawn.load(std::memory_order_relaxed)) {
+          m_wasDrawn.store(true, std::memory_order_relaxed);
+          ChunkLifecycle::RecordFirstDraw(m_requestedAt.load(std::memory_order_relaxed), ChunkLifecycle::GetTimestamp());
+        }
+#endif
       }
 
       [[nodiscard]] inline auto GetChunkPos() const -> glm::ivec2 { return m_chunkPos; }
@@ -107,31 +281,58 @@ namespace TinyMinecraft {
         static constexpr int BLOCK_COUNT = CHUNK_WIDTH * CHUNK_LENGTH * CHUNK_HEIGHT;
 
         std::vector<BlockType> blocks;
-        std::vector<FaceGeometry> translucentFaces;
+        std::array<uint8_t, CHUNK_WIDTH * CHUNK_LENGTH> heightmap{};
       } m_data;
 
-      std::unique_ptr<Geometry::Mesh> m_opaqueMesh, m_translucentMesh;
-      std::vector<Geometry::MeshVertex> m_opaqueVertices, m_translucentVertices;
-      std::vector<GLuint> m_opaqueIndices, m_translucentIndices;
+      // of m_data, as counted by the MemoryTracker
+      [[nodiscard]] inline auto GetBlockBytes() const -> int64_t { return static_cast<int64_t>(m_data.blocks.capacity() * sizeof(BlockType)); }
+
+      // main thread only
+      std::unique_ptr<Geometry::Mesh> m_translucentMesh;
+      std::shared_ptr<TranslucentGeometry> m_translucentGeometry;
 
       bool m_hidden = true;
       std::atomic<ChunkState> m_state { ChunkState::Empty };
-      std::atomic<bool> m_dirty = false;
       std::atomic<bool> m_shouldClear = false;
-      std::atomic<bool> m_translucentDirty = false;
 
-      bool m_hasTranslucentBlocks = false;
+      // lifecycle timestamps, relaxed as the state transitions already order them
+      std::atomic<uint64_t> m_requestedAt = 0, m_stageQueuedAt = 0, m_stageStartedAt = 0;
+      std::atomic<uint64_t> m_workTime = 0;
+      std::atomic<bool> m_wasDrawn = false;
+
+      void RecordTransition(ChunkState from, ChunkState to);
+
+      int m_meshLevel = 0;
+      int m_minHeight = 0, m_maxHeight = CHUNK_HEIGHT - 1;
+
+      auto ComputeSectionConnectivity(int section) -> SectionConnectivity;
 
       std::array<std::shared_ptr<Chunk>, 4> neighborRefs; // east, west, north, south
 
+      // the batch each neighbour posted last but not yet applied, and the latest applied one of every neighbour,
+      // both at the FeatureBatchIndex of the neighbour. Kept across unloads so a regenerated chunk gets its
+      // border features back.
+      std::array<std::atomic<FeatureBatch *>, 9> m_featureInbox {};
+      std::array<std::unique_ptr<FeatureBatch>, 9> m_featureBatches;
+
       auto GetBlockUnbounded(const glm::ivec3 &pos) -> BlockType;
       auto IsFaceVisible(BlockType block, Geometry::Face face, const glm::vec3 &pos) -> bool;
 
       void AppendOpaqueBlockGeometry(BlockType block, glm::vec3 pos, GLuint &indexOffset, std::vector<Geometry::MeshVertex> &vertices, std::vector<GLuint> &indices);
-      void AppendTranslucentBlockGeometry(BlockType block, glm::vec3 pos, std::vector<FaceGeometry> &translucentFaces);
+      // one face of a `size` blocks wide cube whose lowest corner is `pos`
+      void AppendOpaqueFaceGeometry(BlockType block, Geometry::Face face, glm::vec3 pos, float size, GLuint &indexOffset, std::vector<Geometry::MeshVertex> &vertices, std::vector<GLuint> &indices);
+
+      // what a cell of the given level is drawn as: the top block of its opaque blocks if they fill at least
+      // half of it, Air otherwise
+      [[nodiscard]] auto GetCellBlock(int level, const glm::ivec3 &cell) -> BlockType;
+      void AppendLodGeometry(int level, GLuint &indexOffset, ChunkMesh &mesh);
+      // faces neighbours culled against blocks the coarser cells of this chunk do not draw
+      void AppendLodSkirts(int level, const std::vector<BlockType> &cells, GLuint &indexOffset, ChunkMesh &mesh);
+      [[nodiscard]] auto BuildTranslucentGeometry(const glm::vec3 &playerPos) -> std::shared_ptr<TranslucentGeometry>;
+      void AppendTranslucentBlockGeometry(BlockType block, glm::vec3 pos, const glm::vec3 &playerPos, std::vector<FaceGeometry> &translucentFaces);
       
       void AppendOpaqueFluidGeometry(BlockType block, glm::vec3 pos, GLuint &indexOffset, std::vector<Geometry::MeshVertex> &vertices, std::vector<GLuint> &indices);
-      void AppendTranslucentFluidGeometry(BlockType block, glm::vec3 pos, std::vector<FaceGeometry> &translucentFaces);
+      void AppendTranslucentFluidGeometry(BlockType block, glm::vec3 pos, const glm::vec3 &playerPos, std::vector<FaceGeometry> &translucentFaces);
       
       void AppendFoliageGeometry(BlockType block, glm::vec3 pos, GLuint &indexOffset, std::vector<Geometry::MeshVertex> &vertices, std::vector<GLuint> &indices);
     };
@@ -0,0 +1,70 @@
+#ifndef CHUNK_LIFECYCLE_H_
+#define CHUNK_LIFECYCLE_H_
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+namespace TinyMinecraft {
+
+  namespace World {
+
+    enum class ChunkState : uint8_t;
+
+    // the work a chunk is queued for in each of the working states
+    enum class ChunkStage : uint8_t {
+      Generate = 0,   // Generating
+      Decorate,       // Decorating
+      Finalize,       // Finalizing
+      Mesh,           // Meshing
+      Unload,         // Unloading
+    };
+
+    constexpr size_t CHUNK_STAGE_COUNT = 5;
+
+    // durations in nanoseconds
+    struct ChunkStageStats {
+      uint64_t count = 0;
+      long long waitP50 = 0, waitP99 = 0;   // queued until a worker picked it up
+      long long runP50 = 0, runP99 = 0;     // picked up until done
+      long long totalRun = 0;
+    };
+
+    struct ChunkLifecycleStats {
+      std::array<ChunkStageStats, CHUNK_STAGE_COUNT> stages;
+
+      // from Empty to the first frame the chunk was drawn in
+      uint64_t drawnCount = 0;
+      long long requestToDrawP50 = 0, requestToDrawP90 = 0, requestToDrawP99 = 0, requestToDrawMax = 0;
+
+      // chunks unloaded before they were ever drawn, and the worker time spent on them
+      uint64_t undrawnUnloadCount = 0;
+      long long undrawnWork = 0;
+    };
+
+    // Latencies of the chunk pipeline, recorded by Chunk::SetState on every transition and by the renderer on the
+    // first draw of a chunk, to see where streaming time goes and how much work is thrown away.
+    class ChunkLifecycle {
+    public:
+      [[nodiscard]] static inline auto GetTimestamp() -> uint64_t {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+      }
+
+      [[nodiscard]] static auto GetStage(ChunkState state) -> std::optional<ChunkStage>;
+      [[nodiscard]] static auto GetStageName(ChunkStage stage) -> const char *;
+
+      static void RecordStage(ChunkStage stage, uint64_t queuedAt, uint64_t startedAt, uint64_t finishedAt);
+      static void RecordFirstDraw(uint64_t requestedAt, uint64_t drawnAt);
+      static void RecordUndrawnUnload(uint64_t workTime);
+
+      // everything since the start or the last reset, like Utils::Profiler::Snapshot
+      [[nodiscard]] static auto Snapshot(bool reset = false) -> ChunkLifecycleStats;
+      static void LogSummary(bool reset = false);
+    };
+
+  }
+
+}
+
+#endif // CHUNK_LIFECYCLE_H_
@@ -0,0 +1,120 @@
+#ifndef FAR_TERRAIN_H_
+#define FAR_TERRAIN_H_
+
+#include "Geometry/Mesh.h"
+#include "Utils/NonCopyable.h"
+#include "Utils/defs.h"
+#include "Utils/mathgl.h"
+#include "World/BlockType.h"
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <tbb/concurrent_queue.h>
+#include <unordered_set>
+#include <vector>
+
+namespace TinyMinecraft {
+
+  namespace World {
+
+    class WorldGeneration;
+
+    // tile of the far terrain quadtree, covering FarTerrain::GetTileChunks(level) chunks per side from pos times that
+    struct FarTileKey {
+      glm::ivec2 pos;
+      int level;
+
+      auto operator==(const FarTileKey &other) const -> bool = default;
+    };
+
+    struct FarTileKeyHash {
+      auto operator()(const FarTileKey &key) const noexcept -> std::size_t {
+        return Utils::IVec2Hash()(key.pos) ^ (static_cast<std::size_t>(key.level) << 24);
+      }
+    };
+
+    // vertices of one tile in world coordinates; every tile shares the triangles of FarTerrain::GetTileIndices
+    struct FarTile {
+      FarTileKey key;
+      std::vector<Geometry::MeshVertex> vertices;
+      glm::vec3 min, max;
+
+      [[nodiscard]] inline auto GetSizeInBytes() const -> size_t { return vertices.size() * sizeof(Geometry::MeshVertex); }
+    };
+
+    // Coarse heightfield of the terrain from the end of the chunks out to GFX_FAR_DISTANCE chunks. Tiles form a
+    // quadtree split near the player, so every tile has the same number of samples and covers less ground the
+    // closer it is. Tiles are built on the world's workers from the 2D terrain maps only and cached on disk.
+    class FarTerrain : private Utils::NonCopyable {
+    public:
+      static constexpr int LEVEL_COUNT = 4;
+      static constexpr int BASE_TILE_CHUNKS = 16;   // at level 0
+      static constexpr int RESOLUTION = 32;         // quads along a side
+      static constexpr int SAMPLES = RESOLUTION + 1;
+
+      // the grid, then a skirt hanging down from each edge to hide cracks against tiles of another level
+      static constexpr size_t TILE_VERTEX_COUNT = SAMPLES * SAMPLES + 4 * SAMPLES;
+      static constexpr size_t TILE_INDEX_COUNT = 6 * (RESOLUTION * RESOLUTION + 4 * RESOLUTION);
+
+      FarTerrain(const WorldGeneration &generation, int seed);
+
+      // reselects the tiles when the player entered another chunk, returns whether it did
+      auto Update(const glm::ivec2 &playerChunkPos) -> bool;
+      // tiles selected since the last call that have to be built
+      [[nodiscard]] auto TakeRequests() -> std::vector<FarTileKey>;
+      // reads the tile from the cache or generates and caches it; called by the workers
+      void Build(const FarTileKey &key);
+
+      [[nodiscard]] inline auto GetSelection() const -> const std::vector<FarTileKey> & { return m_selection; }
+      [[nodiscard]] inline auto IsSelected(const FarTileKey &key) const -> bool { return m_selected.contains(key); }
+      // changes with every new selection
+      [[nodiscard]] inline auto GetSelectionVersion() const -> uint64_t { return m_selectionVersion; }
+
+      // pops a tile built by the workers, possibly one that is not selected anymore
+      [[nodiscard]] inline auto PollTile(std::shared_ptr<const FarTile> &tile) -> bool { return m_builtTiles.try_pop(tile); }
+
+      [[nodiscard]] static inline auto GetTileChunks(int level) -> int { return BASE_TILE_CHUNKS << level; }
+      [[nodiscard]] static auto GetTileIndices() -> const std::vector<GLuint> &;
+
+    private:
+      using KeySet = std::unordered_set<FarTileKey, FarTileKeyHash>;
+
+      // bump when world generation changes
+      static constexpr uint32_t CACHE_VERSION = 1;
+      // fraction of its size a tile may be from the player before it is split
+      static constexpr float SPLIT_DISTANCE = 1.0f;
+
+      const WorldGeneration &m_generation;
+      std::filesystem::path m_cacheDirectory;
+      // the directory is created by the first tile written, so worlds that never build one leave no trace
+      mutable std::once_flag m_cacheDirectoryCreated;
+      mutable std::atomic<bool> m_isCacheEnabled = true;
+
+      glm::ivec2 m_playerChunkPos { 0 };
+      bool m_hasSelection = false;
+      std::vector<FarTileKey> m_selection;
+      KeySet m_selected;
+      uint64_t m_selectionVersion = 0;
+
+      // selected tiles submitted for building, forgotten once deselected so they are built again if they return
+      KeySet m_requested;
+      std::vector<FarTileKey> m_requests;
+
+      tbb::concurrent_queue<std::shared_ptr<const FarTile>> m_builtTiles;
+
+      void Select(const FarTileKey &key);
+
+      [[nodiscard]] auto GetCachePath(const FarTileKey &key) const -> std::filesystem::path;
+      auto ReadCache(const FarTileKey &key, std::vector<int16_t> &heights, std::vector<BlockType> &blocks) const -> bool;
+      void WriteCache(const FarTileKey &key, const std::vector<int16_t> &heights, const std::vector<BlockType> &blocks) const;
+
+      static void BuildVertices(FarTile &tile, const glm::ivec2 &origin, int spacing, const std::vector<int16_t> &heights, const std::vector<BlockType> &blocks);
+    };
+
+  }
+
+}
+
+#endif // FAR_TERRAIN_H_
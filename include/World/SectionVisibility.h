@@ -0,0 +1,64 @@
+#ifndef SECTION_VISIBILITY_H_
+#define SECTION_VISIBILITY_H_
+
+#include "Geometry/Frustum.h"
+#include "Utils/defs.h"
+#include "Utils/mathgl.h"
+#include "World/Chunk.h"
+#include <cstdint>
+#include <vector>
+
+namespace TinyMinecraft {
+
+  namespace World {
+
+    // Potentially visible set of chunk sections. Walks breadth-first from the camera's section, only leaving
+    // a section through faces its connectivity graph links to the face it was entered from, never heading
+    // back towards the camera, and skipping sections outside the frustum. Needs no GL context.
+    class SectionVisibility {
+    public:
+      // `visibility` holds the mesh data of each of `chunks`; chunks missing from them block the walk
+      void Compute(const std::vector<Chunk *> &chunks, const std::vector<ChunkVisibility> &visibility, const glm::vec3 &cameraPos, const Geometry::Frustum &frustum);
+
+      [[nodiscard]] inline auto IsChunkVisible(size_t chunkIndex) const -> bool { return m_chunkVisible[chunkIndex]; }
+      [[nodiscard]] inline auto IsSectionVisible(size_t chunkIndex, int section) const -> bool {
+        return m_sectionStates[chunkIndex * CHUNK_SECTION_COUNT + section] == SectionState::Visible;
+      }
+
+      [[nodiscard]] inline auto GetSectionCount() const -> size_t { return m_sectionStates.size(); }
+      [[nodiscard]] inline auto GetVisibleSectionCount() const -> size_t { return m_visibleSectionCount; }
+      [[nodiscard]] inline auto GetCulledFraction() const -> float {
+        return GetSectionCount() > 0 ? 1.0f - static_cast<float>(m_visibleSectionCount) / GetSectionCount() : 0.0f;
+      }
+
+    private:
+      enum class SectionState : uint8_t {
+        Unvisited,
+        Visible,
+        Rejected
+      };
+
+      struct Step {
+        glm::ivec3 section; // chunk x, section index, chunk z
+        size_t chunkIndex;
+        Geometry::Face entryFace;
+        uint8_t directions;  // faces walked through so far
+      };
+
+      // dense grid over the bounding rectangle of the chunks, -1 where there is no chunk
+      std::vector<int32_t> m_chunkGrid;
+      glm::ivec2 m_gridMin { 0 }, m_gridSize { 0 };
+      std::vector<SectionState> m_sectionStates;
+      std::vector<uint8_t> m_chunkVisible;
+      std::vector<Step> m_queue;
+      size_t m_visibleSectionCount = 0;
+
+      void MarkAllVisible();
+      [[nodiscard]] auto FindChunk(int x, int z) const -> int32_t;
+    };
+
+  }
+
+}
+
+#endif // SECTION_VISIBILITY_H_
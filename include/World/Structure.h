@@ -0,0 +1,59 @@
+#ifndef STRUCTURE_H_
+#define STRUCTURE_H_
+
+#include "Utils/mathgl.h"
+#include "World/BlockType.h"
+#include "World/Chunk.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace TinyMinecraft {
+
+  namespace World {
+
+    // a row of identical blocks going east (+x), relative to the structure origin
+    struct StructureRun {
+      int8_t x;
+      int8_t z;
+      uint8_t length;
+      BlockType block;
+    };
+
+    struct StructureLayer {
+      std::vector<StructureRun> runs;
+      // inclusive footprint (x, z) of the layer, relative to the origin
+      glm::ivec2 min;
+      glm::ivec2 max;
+    };
+
+    // feature template loaded from data/structures, compiled into runs so it can be stamped without
+    // visiting empty cells
+    class Structure {
+    public:
+      static auto Load(const std::string &path) -> Structure;
+
+      // places the bottom layer at local `anchor` of `chunk`. Blocks past the chunk border go to the
+      // batch of the neighbour that owns them.
+      void Stamp(Chunk *chunk, const glm::ivec3 &anchor, FeatureBatches &outside) const;
+
+      [[nodiscard]] inline auto GetName() const -> const std::string & { return m_name; }
+      [[nodiscard]] inline auto GetHeight() const -> int { return static_cast<int>(m_layers.size()); }
+      // largest horizontal distance from the origin to any block
+      [[nodiscard]] inline auto GetRadius() const -> int {
+        return std::max(std::max(-m_min.x, m_max.x), std::max(-m_min.y, m_max.y));
+      }
+    private:
+      std::string m_name;
+      std::vector<StructureLayer> m_layers;
+      glm::ivec2 m_min;
+      glm::ivec2 m_max;
+
+      static void StampRun(Chunk *chunk, int x, int y, int z, int length, BlockType block, FeatureBatches &outside);
+    };
+
+  }
+
+}
+
+#endif // STRUCTURE_H_
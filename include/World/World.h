@@ -6,9 +6,13 @@
 #include "Utils/mathgl.h"
 #include "World/BlockType.h"
 #include "World/Chunk.h"
+#include "World/FarTerrain.h"
 #include "World/WorldGeneration.h"
+#include <algorithm>
+#include <array>
 #include <functional>
 #include <queue>
+#include <tbb/concurrent_queue.h>
 #include <tbb/concurrent_unordered_map.h>
 #include <memory>
 #include <thread>
@@ -19,9 +23,24 @@ namespace TinyMinecraft {
     using ChunkMap = tbb::concurrent_unordered_map<glm::ivec2, std::shared_ptr<Chunk>, Utils::IVec2Hash>;
     using BlockLocation = std::tuple<glm::vec3, Geometry::Face, BlockType>;
 
+    // lets the renderer keep its list of drawable chunks without scanning the chunk map
+    struct ChunkRenderEvent {
+      enum class Type : uint8_t {
+        Meshed,   // became Loaded, possibly again after a block change
+        Unloaded
+      };
+
+      Chunk *chunk;
+      Type type;
+      std::shared_ptr<const ChunkMesh> mesh; // Meshed only
+    };
+
     class World {
     public:
-      World();
+      static constexpr int DEFAULT_SEED = 0;
+
+      // 0 workers uses one per hardware thread
+      World(int seed = DEFAULT_SEED, unsigned int workerCount = 0);
       ~World();
 
       auto GetTemperature(int x, int z) -> double;
@@ -35,8 +54,19 @@ namespace TinyMinecraft {
       auto GetBiome(int x, int z) -> BiomeType;
 
       void Update(const glm::vec3 &playerPos);
+      // blocks until the given chunks are Generated, without meshing them or anything around them
+      void GenerateChunks(const std::vector<glm::ivec2> &chunkPositions);
       void RefreshChunkAt(const glm::vec3 &pos);
 
+      // pops the oldest render event; pushed by the workers, so only one thread should poll
+      [[nodiscard]] inline auto PollRenderEvent(ChunkRenderEvent &event) -> bool { return m_renderEvents.try_pop(event); }
+
+      // tasks handed to the workers so far, and whether any of them is still queued or running
+      [[nodiscard]] inline auto GetSubmittedTaskCount() const -> size_t { return m_submittedTaskCount.load(); }
+      [[nodiscard]] inline auto HasPendingTasks() const -> bool { return m_finishedTaskCount.load() != m_submittedTaskCount.load(); }
+
+      [[nodiscard]] inline auto GetFarTerrain() -> FarTerrain & { return m_farTerrain; }
+
       void BreakBlock(const glm::vec3 &pos);
       void SetBlockAt(const glm::vec3 &pos, BlockType type);
 
@@ -74,25 +104,44 @@ namespace TinyMinecraft {
       void HandlePlayerMovement(const glm::vec3 &before, const glm::vec3 &after);
 
     private:
-      const unsigned int seed = 3782;
+      const int m_seed;
 
       std::atomic<bool> m_shouldTerminate;
       std::condition_variable m_nonempty;
       std::mutex m_taskMutex;
 
       std::queue<std::function<void()>> m_tasks;
+      std::atomic<size_t> m_submittedTaskCount = 0, m_finishedTaskCount = 0;
       std::vector<std::thread> m_workers;
 
       glm::vec3 m_playerPosition;
 
       ChunkMap m_chunks;
       WorldGeneration m_worldGen;
+      FarTerrain m_farTerrain;
+      tbb::concurrent_queue<ChunkRenderEvent> m_renderEvents;
 
       void SubmitTask(std::function<void()> task);
       void ScheduleGenerateTask(Chunk *chunk);
+      void ScheduleDecorateTask(Chunk *chunk);
+      void ScheduleFinalizeTask(Chunk *chunk);
       void ScheduleUnloadTask(Chunk *chunk);
       void ScheduleMeshTask(Chunk *chunk);
+
+      // detail level chunks are meshed at, by distance to the player
+      [[nodiscard]] auto GetMeshLevel(const glm::ivec2 &chunkPos) -> int;
+
+      // schedules the next generation stage of `chunk` if its neighbors allow it
+      auto AdvanceGeneration(Chunk *chunk, const glm::ivec2 &chunkPos, ChunkState state) -> bool;
       
+      template <size_t N>
+      [[nodiscard]] auto AreNeighborsAtLeast(const glm::ivec2 &chunkPos, const std::array<glm::ivec2, N> &offsets, ChunkState state) const -> bool {
+        return std::ranges::all_of(offsets, [&](const glm::ivec2 &offset) {
+          const glm::ivec2 pos = chunkPos + offset;
+          return HasChunk(pos) && GetChunkAt(pos)->GetState() >= state;
+        });
+      }
+
       void DoTasks(int i);
     };
 
@@ -10,6 +10,8 @@
 #include "Utils/mathgl.h"
 #include "World/Biome.h"
 #include "World/Chunk.h"
+#include "World/Structure.h"
+#include <array>
 #include <functional>
 
 namespace TinyMinecraft {
@@ -25,20 +27,35 @@ namespace TinyMinecraft {
 
     class WorldGeneration {
     public:
-      WorldGeneration(World &world);
+      WorldGeneration(World &world, int seed);
       void GenerateTerrainChunk(Chunk *chunk);
       void GenerateFeatures(Chunk *chunk);
-
-      void LoadUnloadedBlocks(Chunk *chunk);
+      // surface of a `size` x `size` grid of columns `spacing` blocks apart from `origin`, a multiple of `spacing`.
+      // Uses the 2D maps only, without the 3D terrain noise, caves or features, so heights are approximate.
+      void GenerateHeightmap(const glm::ivec2 &origin, int spacing, int size, std::vector<int16_t> &heights, std::vector<BlockType> &blocks) const;
 
       auto SelectBiomes(double temperature, double humidity) const -> std::pair<const Biome*, const Biome*>;
     private:
       World &m_world;
+      // offsets the seed of every noise source
+      int m_seed;
       std::unordered_map<BiomeType, Biome> m_biomes;
-      std::unordered_map<glm::ivec2, std::vector<std::pair<glm::vec3, BlockType>>, Utils::IVec2Hash> m_unloadedBlocks;
+      Structure m_tree;
+
+      // per-column inputs of the surface pass, indexed x-major like the FastNoise 2D grids
+      struct SurfaceMaps {
+        std::array<int, CHUNK_WIDTH * CHUNK_LENGTH> heights;
+        std::array<float, CHUNK_WIDTH * CHUNK_LENGTH> temperature;
+        std::array<float, CHUNK_WIDTH * CHUNK_LENGTH> humidity;
+        std::array<float, CHUNK_WIDTH * CHUNK_LENGTH> stone;
+      };
+
+      void DecorateSurface(Chunk *chunk, const SurfaceMaps &maps);
+      // terrain height of a column before the 3D terrain noise
+      [[nodiscard]] auto GetBaseHeight(float continentalnessNoise, float erosionNoise, float peaksNoise) const -> int;
 
       auto CanTreeSpawn(Chunk *chunk, int x, int surfaceY, int z, int radius) -> bool;
-      void SpawnTree(Chunk *chunk, int x, int surfaceY, int z);
+      void PostFeatureBatches(Chunk *chunk, FeatureBatches &outside);
       [[nodiscard]] auto StringToSplineMethod(const std::string &method) -> SplineMethod {
         if (method == "monotonic_natural")
           return SplineMethod::MonotonicNatural;
@@ -7,7 +7,10 @@ in vec4 lightSpacePos;
 
 uniform sampler2D uBlockAtlas;
 uniform sampler2D uShadowMap;
-uniform vec3 uCameraPos;
+layout (std140) uniform FrameUniforms {
+  mat4 uViewProjection;
+  vec4 uCameraPos;
+};
 
 out vec4 FragColor;
 
@@ -73,7 +76,7 @@ void main()
   int lightsCount = 1;
 
   vec3 irradiance = material.ambientReflection * ambience;
-  vec3 cameraDirection = normalize(uCameraPos - position);
+  vec3 cameraDirection = normalize(uCameraPos.xyz - position);
 
   for (int i = 0; i < 1; ++i) {
     // diffuse contribution
@@ -5,7 +5,10 @@ layout (location = 1) in vec4 aColor;
 layout (location = 2) in vec2 aTexCoord;
 layout (location = 3) in vec3 aNormal;
 
-uniform mat4 uViewProjection;
+layout (std140) uniform FrameUniforms {
+  mat4 uViewProjection;
+  vec4 uCameraPos;
+};
 uniform mat4 uModel;
 uniform mat4 uLightViewProjection;
 
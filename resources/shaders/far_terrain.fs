@@ -0,0 +1,32 @@
+#version 330
+
+in vec3 position;
+in vec3 normal;
+flat in vec2 texCoord;
+
+uniform sampler2D uBlockAtlas;
+// the chunks are drawn inside this circle
+uniform vec2 uInnerCenter;
+uniform float uInnerRadius;
+
+out vec4 FragColor;
+
+// mip level where a block texture is a single texel, its average color
+const float blockLod = 5.0;
+
+// same light as block_solid
+const vec3 ambience = vec3(0.1);
+const vec3 diffuse = vec3(0.6 * 0.3);
+const vec3 lightDirection = normalize(vec3(-40, 80, -50));
+
+void main()
+{
+  if (distance(position.xz, uInnerCenter) < uInnerRadius) {
+    discard;
+  }
+
+  vec3 texColor = textureLod(uBlockAtlas, texCoord, blockLod).rgb;
+  vec3 irradiance = ambience + diffuse * max(0.0, dot(lightDirection, normalize(normal)));
+
+  FragColor = vec4(irradiance * texColor, 1.0f);
+}
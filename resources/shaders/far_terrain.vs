@@ -0,0 +1,24 @@
+#version 330 core
+
+layout (location = 0) in vec3 aPos;
+layout (location = 2) in vec2 aTexCoord;
+layout (location = 3) in vec3 aNormal;
+
+layout (std140) uniform FrameUniforms {
+  mat4 uViewProjection;
+  vec4 uCameraPos;
+};
+
+out vec3 position;
+out vec3 normal;
+// one block per triangle, blending two tiles of the atlas would give a third
+flat out vec2 texCoord;
+
+void main()
+{
+  position = aPos;
+  normal = aNormal;
+  texCoord = aTexCoord;
+
+  gl_Position = uViewProjection * vec4(aPos, 1.0f);
+}
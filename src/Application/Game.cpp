@@ -1,17 +1,27 @@
 #include "Application/Game.h"
 #include "Application/InputHandler.h"
+#include "Application/OcclusionBenchmark.h"
 #include "Entity/Player.h"
 #include "Entity/PlayerController.h"
+#include "Events/EventHandler.h"
+#include "Events/World/ChunkEvents.h"
 #include "Geometry/geometry.h"
+#include "Graphics/Device.h"
 #include "Graphics/Renderer.h"
 #include "Graphics/Renderer2D.h"
+#include "Graphics/RenderState.h"
 #include "Graphics/WireframeRenderer.h"
 #include "Scene/PlayerCameras.h"
+#include "Utils/AllocationCounter.h"
 #include "Utils/defs.h"
+#include "Utils/Logger.h"
+#include "Utils/MemoryTracker.h"
 #include "Utils/Profiler.h"
+#include "Utils/SamplingProfiler.h"
 #include "World/Biome.h"
 #include "World/Block.h"
 #include "World/BlockType.h"
+#include "World/ChunkLifecycle.h"
 #include "World/World.h"
 #include <chrono>
 #include <algorithm>
@@ -44,6 +54,17 @@ namespace TinyMinecraft {
       );
       m_player.SetWorld(m_world);
 
+      // how long until the chunk the player starts in can be seen
+      Event::EventHandler::On<Event::ChunkLoadedEvent>([this, start = std::chrono::steady_clock::now(), isLoaded = false](const Event::ChunkLoadedEvent &e) mutable {
+        if (isLoaded || e.GetChunkPos() != m_world->GetChunkPosFromCoords(m_player.GetPosition())) {
+          return;
+        }
+        isLoaded = true;
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        Utils::Logger::Message("Spawn chunk loaded after {} ms.", elapsed.count());
+      });
+
       InputHandler::Initialize();
     }
 
@@ -62,6 +83,18 @@ namespace TinyMinecraft {
       const double displayFPSInterval = 1000.f; // ms
     #endif
 
+      double memoryTimer = 0.0;
+      const double memoryCheckInterval = 1000.0; // ms, reading the resident size takes a syscall
+
+    #ifdef UTILS_CountAllocations
+      Utils::AllocationCount frameAllocationsStart = Utils::AllocationCounter::GetThreadCount();
+    #endif
+    #if defined(UTILS_CountAllocations) && defined(UTILS_FRAME_ALLOCATION_BUDGET)
+      int overBudgetFrames = 0;
+      uint64_t mostFrameAllocations = 0;
+      auto lastBudgetWarning = clock::now();
+    #endif
+
       while (!m_window.ShouldClose()) {
         m_window.PollEvents();
 
@@ -78,8 +111,44 @@ namespace TinyMinecraft {
           Update();
           lag -= FIXED_UPDATE_INTERVAL;
         }
+
+        // the moves of all the updates above as one, and what the chunk workers posted
+        Event::EventHandler::DispatchQueued();
         
         Render(lag / FIXED_UPDATE_INTERVAL);
+        PROFILE_FRAME()
+
+        memoryTimer += frameTime;
+        if (memoryTimer >= memoryCheckInterval) {
+          memoryTimer = 0.0;
+          m_ui.SetMemoryStats(Utils::MemoryTracker::GetStats());
+          Utils::MemoryTracker::CheckBudgets();
+        }
+
+    #ifdef UTILS_CountAllocations
+        // from the end of the last frame, so polling the events counts too
+        const Utils::AllocationCount frameAllocationsEnd = Utils::AllocationCounter::GetThreadCount();
+        const Utils::AllocationCount frameAllocations = frameAllocationsEnd - frameAllocationsStart;
+        frameAllocationsStart = frameAllocationsEnd;
+
+        m_ui.SetFrameAllocations(frameAllocations.count, frameAllocations.bytes);
+        PROFILE_COUNTER("frame allocations", frameAllocations.count)
+    #endif
+
+    #if defined(UTILS_CountAllocations) && defined(UTILS_FRAME_ALLOCATION_BUDGET)
+        if (frameAllocations.count > UTILS_FRAME_ALLOCATION_BUDGET) {
+          ++overBudgetFrames;
+          mostFrameAllocations = std::max(mostFrameAllocations, frameAllocations.count);
+        }
+
+        // a warning every frame would flood the log, and be over budget itself
+        if (overBudgetFrames > 0 && currentTime - lastBudgetWarning >= std::chrono::seconds(1)) {
+          Utils::Logger::Warning("{} frames allocated more than {} times on the main thread, at most {}.", overBudgetFrames, UTILS_FRAME_ALLOCATION_BUDGET, mostFrameAllocations);
+          overBudgetFrames = 0;
+          mostFrameAllocations = 0;
+          lastBudgetWarning = currentTime;
+        }
+    #endif
 
     #ifdef UTILS_ShowFPS
         frameCount++;
@@ -118,6 +187,35 @@ namespace TinyMinecraft {
       );
 
       m_world->Update(m_player.GetPosition());
+
+      if (InputHandler::IsKeyPressed(GLFW_KEY_F6)) {
+        SaveCameraPose("../data/occlusion_poses.json", pos, m_player.GetYaw(), m_player.GetPitch());
+      }
+
+      if (InputHandler::IsKeyPressed(GLFW_KEY_F7)) {
+        if (Utils::Profiler::IsCapturing()) {
+          Utils::Profiler::EndCapture();
+        } else {
+          Utils::Profiler::BeginCapture();
+        }
+      }
+
+      if (InputHandler::IsKeyPressed(GLFW_KEY_F9)) {
+        if (Utils::SamplingProfiler::IsRunning()) {
+          Utils::SamplingProfiler::Stop();
+        } else {
+          Utils::SamplingProfiler::Start();
+        }
+      }
+
+      // the profile since the last F8, to measure one phase like a fast flight
+      if (InputHandler::IsKeyPressed(GLFW_KEY_F8)) {
+        Utils::Profiler::LogSummary(true);
+      #ifdef UTILS_ChunkLifecycle
+        World::ChunkLifecycle::LogSummary(true);
+      #endif
+        Utils::MemoryTracker::LogSummary();
+      }
     }
 
     void Game::Render(double) {
@@ -138,6 +236,12 @@ namespace TinyMinecraft {
     #endif
 
         m_renderer.RenderWorld(*m_world);
+        const Graphics::RenderStats &stats = m_renderer.GetStats();
+        m_ui.SetChunkCounts(stats.drawnChunks, stats.culledChunks, stats.occludedChunks, stats.hiddenChunks, stats.culledSectionFraction);
+        m_ui.SetMeshUploads(stats.pendingMeshes, stats.uploadedBytes);
+    #ifdef UTILS_ChunkLifecycle
+        m_ui.SetChunkLifecycle(World::ChunkLifecycle::Snapshot());
+    #endif
 
       m_renderer.End3D();
 
@@ -152,11 +256,17 @@ namespace TinyMinecraft {
 
       Graphics::WireframeRenderer::Render(m_camera);
       
+      // counts of the previous frame, this one is not finished yet
+      const Graphics::RenderState::FrameStats &glStats = Graphics::RenderState::GetFrameStats();
+      m_ui.SetGLCalls(glStats.GetCallCount(), glStats.drawCalls, glStats.skippedStateChanges);
+
       Graphics::Renderer2D::BeginScene(m_ortho);
         m_renderer.RenderUI(m_ui);
       Graphics::Renderer2D::EndScene();
 
       m_window.SwapBuffers();
+      Graphics::RenderState::EndFrame();
+      Graphics::Device::EndFrame();
     }
 
   }
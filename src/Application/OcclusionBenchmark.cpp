@@ -0,0 +1,191 @@
+#include "Application/OcclusionBenchmark.h"
+
+#include "Geometry/Frustum.h"
+#include "Graphics/ChunkCuller.h"
+#include "Utils/Logger.h"
+#include "Utils/defs.h"
+#include "Utils/mathgl.h"
+#include "World/World.h"
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace TinyMinecraft {
+
+  namespace Application {
+
+    namespace {
+
+      // same as the game's camera
+      constexpr float fov = 45.0f;
+      constexpr float aspectRatio = 16.0f / 9.0f;
+      constexpr float nearPlane = 0.1f;
+      constexpr float farPlane = 2048.0f;
+
+      constexpr int iterations = 100;
+
+      struct CameraPose {
+        glm::vec3 position;
+        float yaw, pitch;
+      };
+
+      auto GetViewProjection(const CameraPose &pose) -> glm::mat4 {
+        glm::vec3 front;
+        front.x = cos(glm::radians(pose.yaw)) * cos(glm::radians(pose.pitch));
+        front.y = sin(glm::radians(pose.pitch));
+        front.z = sin(glm::radians(pose.yaw)) * cos(glm::radians(pose.pitch));
+        front = glm::normalize(front);
+
+        const glm::vec3 right = glm::normalize(glm::cross(front, glm::vec3(0.0f, 1.0f, 0.0f)));
+        const glm::vec3 up = glm::normalize(glm::cross(right, front));
+
+        const glm::mat4 projection = glm::perspective(glm::radians(fov), aspectRatio, nearPlane, farPlane);
+        return projection * glm::lookAt(pose.position, pose.position + front, up);
+      }
+
+      auto GetChunksAround(const glm::ivec2 &center, int radius) -> std::vector<glm::ivec2> {
+        std::vector<glm::ivec2> chunkPositions;
+
+        for (int dz = -radius; dz <= radius; ++dz) {
+          for (int dx = -radius; dx <= radius; ++dx) {
+            if (dx * dx + dz * dz <= radius * radius) {
+              chunkPositions.push_back(center + glm::ivec2(dx, dz));
+            }
+          }
+        }
+
+        return chunkPositions;
+      }
+
+      auto GetChunkPos(const glm::vec3 &pos) -> glm::ivec2 {
+        return glm::ivec2(static_cast<int>(std::floor(pos.x / CHUNK_WIDTH)), static_cast<int>(std::floor(pos.z / CHUNK_LENGTH)));
+      }
+
+    }
+
+    auto RunOcclusionBenchmark(const std::string &path) -> bool {
+      std::ifstream file(path);
+
+      if (!file.is_open()) {
+        Utils::Logger::Error("Json: file cannot open");
+        return false;
+      }
+
+      nlohmann::json json;
+      file >> json;
+      file.close();
+
+      if (!json["seed"].is_number() || !json["poses"].is_array()) {
+        Utils::Logger::Error("Invalid camera poses at path {}: Missing attributes.", path);
+        return false;
+      }
+
+      const int seed = json["seed"];
+      const int radius = json.value("radius", GFX_RENDER_DISTANCE);
+
+      std::vector<CameraPose> poses;
+      for (const auto &pose : json["poses"]) {
+        const auto &position = pose["position"];
+        poses.push_back(CameraPose{
+          glm::vec3(position[0].get<float>(), position[1].get<float>(), position[2].get<float>()),
+          pose["yaw"].get<float>(),
+          pose["pitch"].get<float>()
+        });
+      }
+
+      // meshing reads one block into each neighbour, so generate one extra ring
+      std::unordered_set<glm::ivec2, Utils::IVec2Hash> generated, meshed;
+      for (const CameraPose &pose : poses) {
+        for (const glm::ivec2 &chunkPos : GetChunksAround(GetChunkPos(pose.position), radius + 1)) {
+          generated.insert(chunkPos);
+        }
+        for (const glm::ivec2 &chunkPos : GetChunksAround(GetChunkPos(pose.position), radius)) {
+          meshed.insert(chunkPos);
+        }
+      }
+
+      World::World world(seed);
+      world.GenerateChunks(std::vector<glm::ivec2>(generated.begin(), generated.end()));
+
+      std::unordered_map<glm::ivec2, World::ChunkVisibility, Utils::IVec2Hash> meshVisibility;
+      for (const glm::ivec2 &chunkPos : meshed) {
+        meshVisibility[chunkPos] = world.GetChunkAt(chunkPos)->UpdateMesh()->visibility;
+      }
+
+      Utils::Logger::Message("Generated {} chunks, meshed {} for {} poses.", generated.size(), meshed.size(), poses.size());
+
+      Graphics::ChunkCuller culler;
+      double totalMilliseconds = 0.0;
+
+      for (size_t i = 0; i < poses.size(); ++i) {
+        const CameraPose &pose = poses[i];
+        const glm::mat4 viewProjection = GetViewProjection(pose);
+
+        std::vector<World::Chunk *> chunks;
+        std::vector<World::ChunkVisibility> visibility;
+        Geometry::BoundingBoxes bounds;
+
+        for (const glm::ivec2 &chunkPos : GetChunksAround(GetChunkPos(pose.position), radius)) {
+          const World::ChunkVisibility &chunkVisibility = meshVisibility.at(chunkPos);
+
+          const glm::vec3 min(chunkPos.x * CHUNK_WIDTH, chunkVisibility.minHeight, chunkPos.y * CHUNK_LENGTH);
+          const glm::vec3 max(min.x + CHUNK_WIDTH, chunkVisibility.maxHeight + 1, min.z + CHUNK_LENGTH);
+
+          chunks.push_back(world.GetChunkAt(chunkPos).get());
+          visibility.push_back(chunkVisibility);
+          bounds.Add(min, max);
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+
+        for (int iteration = 0; iteration < iterations; ++iteration) {
+          culler.Begin(chunks, visibility, bounds, viewProjection, pose.position);
+          culler.Finish();
+        }
+
+        const double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / iterations;
+        totalMilliseconds += milliseconds;
+
+        const Graphics::RenderStats &stats = culler.GetStats();
+        Utils::Logger::Message("Pose {}: {} ms, {} chunks drawn, {} culled, {} occluded, {} hidden.",
+          i, milliseconds, stats.drawnChunks, stats.culledChunks, stats.occludedChunks, stats.hiddenChunks);
+      }
+
+      if (!poses.empty()) {
+        Utils::Logger::Message("Average over {} poses: {} ms.", poses.size(), totalMilliseconds / poses.size());
+      }
+
+      return true;
+    }
+
+    void SaveCameraPose(const std::string &path, const glm::vec3 &position, float yaw, float pitch) {
+      nlohmann::json json;
+
+      std::ifstream file(path);
+      if (file.is_open()) {
+        file >> json;
+        file.close();
+      } else {
+        json["seed"] = World::World::DEFAULT_SEED;
+        json["radius"] = GFX_RENDER_DISTANCE;
+        json["poses"] = nlohmann::json::array();
+      }
+
+      json["poses"].push_back({
+        { "position", { position.x, position.y, position.z } },
+        { "yaw", yaw },
+        { "pitch", pitch }
+      });
+
+      std::ofstream out(path);
+      out << json.dump(2) << '\n';
+      Utils::Logger::Message("Saved camera pose {} to {}.", json["poses"].size() - 1, path);
+    }
+
+  }
+
+}
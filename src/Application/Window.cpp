@@ -2,9 +2,11 @@
 #include "Events/EventHandler.h"
 #include "Events/Input/KeyboardEvents.h"
 #include "Events/Input/MouseEvents.h"
+#include "Graphics/Device.h"
 #include "Graphics/gfx.h"
 #include "Utils/Logger.h"
 #include "Utils/Profiler.h"
+#include "Utils/defs.h"
 
 namespace TinyMinecraft {
 
@@ -50,7 +52,13 @@ namespace TinyMinecraft {
 
       glfwMakeContextCurrent(m_handle);
 
-      if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress))) {
+    #ifdef GFX_RecordDevice
+      constexpr Graphics::DeviceBackend backend = Graphics::DeviceBackend::Recording;
+    #else
+      constexpr Graphics::DeviceBackend backend = Graphics::DeviceBackend::OpenGL;
+    #endif
+
+      if (!Graphics::Device::Initialize(backend, reinterpret_cast<GLADloadproc>(glfwGetProcAddress))) {
         Utils::Logger::Error("GLAD: Error initializing.");
         exit(1);
       }
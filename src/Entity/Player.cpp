@@ -35,14 +35,13 @@ namespace TinyMinecraft {
       m_yaw = m_controller->GetYaw();
       m_pitch = m_controller->GetPitch();
       
+      // dispatched once a frame, as one event however many updates ran in it
       if (oldPosition != m_position) {        
-        Event::PlayerMovedEvent event(*this, oldPosition, m_position);
-        Event::EventHandler::Trigger(event);
+        Event::EventHandler::Post(Event::PlayerMovedEvent(*this, oldPosition, m_position));
       }
 
       if (oldYaw != m_yaw || oldPitch != m_pitch) {
-        Event::PlayerLookedEvent event(*this, oldYaw, oldPitch, m_yaw, m_pitch);
-        Event::EventHandler::Trigger(event);
+        Event::EventHandler::Post(Event::PlayerLookedEvent(*this, oldYaw, oldPitch, m_yaw, m_pitch));
       }
       
       // update block looking at
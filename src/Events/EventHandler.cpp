@@ -1,19 +1,18 @@
 #include "Events/EventHandler.h"
-#include "Utils/Logger.h"
+#include "Utils/Profiler.h"
 
 namespace TinyMinecraft {
 
   namespace Event {
 
-    std::unordered_map<EventType, std::vector<EventHandlerFn>> EventHandler::s_eventListeners;
+    std::vector<void (*)()> EventHandler::s_queueDispatchers;
 
-    void EventHandler::Trigger(const Event &event) {
-      for (auto &fn : s_eventListeners[event.GetEventType()]) {
-        if (fn) {
-          fn(event);
-        } else {
-          Utils::Logger::Error("Error calling function for event {}.", event.ToString());
-        }
+    void EventHandler::DispatchQueued() {
+      PROFILE_FUNCTION(Game)
+
+      // by index, a listener may register the first one of another type
+      for (size_t i = 0; i < s_queueDispatchers.size(); ++i) {
+        s_queueDispatchers[i]();
       }
     }
   }
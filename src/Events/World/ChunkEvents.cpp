@@ -0,0 +1,21 @@
+#include "Events/World/ChunkEvents.h"
+#include <sstream>
+
+namespace TinyMinecraft {
+
+  namespace Event {
+
+    //// CHUNK LOADED EVENT ////
+
+    auto ChunkLoadedEvent::ToString() const -> std::string {
+      std::stringstream ss;
+      ss << "ChunkLoadedEvent(";
+      ss << "Chunk: " << m_chunkPos << ", ";
+      ss << "Level: " << m_meshLevel;
+      ss << ")";
+      return ss.str();
+    }
+
+  }
+
+}
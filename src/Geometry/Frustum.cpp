@@ -0,0 +1,117 @@
+#include "Geometry/Frustum.h"
+
+#if defined(__SSE__) || defined(_M_X64)
+  #include <xmmintrin.h>
+  #define FRUSTUM_USE_SSE
+#endif
+
+namespace TinyMinecraft {
+
+  namespace Geometry {
+
+    void BoundingBoxes::Clear() {
+      minX.clear(); minY.clear(); minZ.clear();
+      maxX.clear(); maxY.clear(); maxZ.clear();
+    }
+
+    void BoundingBoxes::Add(const glm::vec3 &min, const glm::vec3 &max) {
+      minX.push_back(min.x); minY.push_back(min.y); minZ.push_back(min.z);
+      maxX.push_back(max.x); maxY.push_back(max.y); maxZ.push_back(max.z);
+    }
+
+    void BoundingBoxes::Set(size_t index, const glm::vec3 &min, const glm::vec3 &max) {
+      minX[index] = min.x; minY[index] = min.y; minZ[index] = min.z;
+      maxX[index] = max.x; maxY[index] = max.y; maxZ[index] = max.z;
+    }
+
+    void BoundingBoxes::RemoveSwap(size_t index) {
+      for (std::vector<float> *coords : { &minX, &minY, &minZ, &maxX, &maxY, &maxZ }) {
+        (*coords)[index] = coords->back();
+        coords->pop_back();
+      }
+    }
+
+    Frustum::Frustum(const glm::mat4 &viewProjection) {
+      // Gribb-Hartmann: planes are sums of the rows of the clip matrix (glm is column-major)
+      const auto row = [&](int i) {
+        return glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+      };
+
+      m_planes[0] = row(3) + row(0);
+      m_planes[1] = row(3) - row(0);
+      m_planes[2] = row(3) + row(1);
+      m_planes[3] = row(3) - row(1);
+      m_planes[4] = row(3) + row(2);
+      m_planes[5] = row(3) - row(2);
+    }
+
+    auto Frustum::IsBoxVisible(const glm::vec3 &min, const glm::vec3 &max) const -> bool {
+      for (const glm::vec4 &plane : m_planes) {
+        // corner furthest along the plane normal
+        const glm::vec3 corner(
+          plane.x >= 0.0f ? max.x : min.x,
+          plane.y >= 0.0f ? max.y : min.y,
+          plane.z >= 0.0f ? max.z : min.z
+        );
+
+        if (plane.x * corner.x + plane.y * corner.y + plane.z * corner.z + plane.w < 0.0f) {
+          return false;
+        }
+      }
+
+      return true;
+    }
+
+    auto Frustum::CullBoxes(const BoundingBoxes &boxes, std::vector<uint8_t> &visible) const -> size_t {
+      visible.resize(boxes.Size());
+
+#ifdef FRUSTUM_USE_SSE
+      const size_t count = boxes.Size() & ~size_t(3);
+      size_t visibleCount = 0;
+
+      for (size_t i = 0; i < count; i += 4) {
+        __m128 outside = _mm_setzero_ps();
+
+        for (const glm::vec4 &plane : m_planes) {
+          // pick the corner furthest along the normal once per plane instead of once per box
+          const __m128 x = _mm_loadu_ps(&(plane.x >= 0.0f ? boxes.maxX : boxes.minX)[i]);
+          const __m128 y = _mm_loadu_ps(&(plane.y >= 0.0f ? boxes.maxY : boxes.minY)[i]);
+          const __m128 z = _mm_loadu_ps(&(plane.z >= 0.0f ? boxes.maxZ : boxes.minZ)[i]);
+
+          __m128 distance = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(plane.x)), _mm_set1_ps(plane.w));
+          distance = _mm_add_ps(distance, _mm_mul_ps(y, _mm_set1_ps(plane.y)));
+          distance = _mm_add_ps(distance, _mm_mul_ps(z, _mm_set1_ps(plane.z)));
+
+          outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, _mm_setzero_ps()));
+        }
+
+        const int mask = _mm_movemask_ps(outside);
+        for (int lane = 0; lane < 4; ++lane) {
+          visible[i + lane] = (mask & (1 << lane)) == 0;
+          visibleCount += visible[i + lane];
+        }
+      }
+
+      return visibleCount + CullBoxesScalar(boxes, count, visible);
+#else
+      return CullBoxesScalar(boxes, 0, visible);
+#endif
+    }
+
+    auto Frustum::CullBoxesScalar(const BoundingBoxes &boxes, size_t first, std::vector<uint8_t> &visible) const -> size_t {
+      size_t visibleCount = 0;
+
+      for (size_t i = first; i < boxes.Size(); ++i) {
+        visible[i] = IsBoxVisible(
+          glm::vec3(boxes.minX[i], boxes.minY[i], boxes.minZ[i]),
+          glm::vec3(boxes.maxX[i], boxes.maxY[i], boxes.maxZ[i])
+        );
+        visibleCount += visible[i];
+      }
+
+      return visibleCount;
+    }
+
+  }
+
+}
@@ -1,4 +1,5 @@
 #include "Geometry/Mesh.h"
+#include "Graphics/RenderState.h"
 #include "Utils/Logger.h"
 
 namespace TinyMinecraft {
@@ -13,10 +14,14 @@ namespace TinyMinecraft {
       m_vbo.Bind();
       m_ebo.Bind();
 
-      m_vao.AddAttribute(0, 3, GL_FLOAT, sizeof(MeshVertex), offsetof(MeshVertex, position));
-      m_vao.AddAttribute(1, 4, GL_FLOAT, sizeof(MeshVertex), offsetof(MeshVertex, color));
-      m_vao.AddAttribute(2, 2, GL_FLOAT, sizeof(MeshVertex), offsetof(MeshVertex, texCoords));
-      m_vao.AddAttribute(3, 3, GL_FLOAT, sizeof(MeshVertex), offsetof(MeshVertex, normal));
+      AddVertexAttributes(m_vao);
+    }
+
+    void Mesh::AddVertexAttributes(Graphics::VertexArray &vao) {
+      vao.AddAttribute(0, 3, GL_FLOAT, sizeof(MeshVertex), offsetof(MeshVertex, position));
+      vao.AddAttribute(1, 4, GL_FLOAT, sizeof(MeshVertex), offsetof(MeshVertex, color));
+      vao.AddAttribute(2, 2, GL_FLOAT, sizeof(MeshVertex), offsetof(MeshVertex, texCoords));
+      vao.AddAttribute(3, 3, GL_FLOAT, sizeof(MeshVertex), offsetof(MeshVertex, normal));
     }
 
     // Mesh::Mesh(Mesh &&other) noexcept
@@ -33,11 +38,20 @@ namespace TinyMinecraft {
         return;
 
       m_vao.Bind();
-      
-      m_vbo.BufferData(vertices, GL_DYNAMIC_DRAW);
-      m_ebo.BufferData(indices, GL_DYNAMIC_DRAW);
+
+      // re-sorted meshes keep their size, so the storage is only reallocated when it grows
+      if (vertices.size() > m_vertexCapacity || indices.size() > m_indexCapacity) {
+        m_vbo.BufferData(vertices, GL_DYNAMIC_DRAW);
+        m_ebo.BufferData(indices, GL_DYNAMIC_DRAW);
+        m_vertexCapacity = vertices.size();
+        m_indexCapacity = indices.size();
+      } else {
+        m_vbo.BufferSubData(0, vertices);
+        m_ebo.BufferSubData(0, indices);
+      }
 
       m_vertexCount = indices.size();
+      Graphics::RenderState::CountBufferUpload();
 
       vertices.clear();
       vertices.shrink_to_fit();
@@ -0,0 +1,227 @@
+#include "Geometry/OcclusionBuffer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64)
+  #include <emmintrin.h>
+  #define OCCLUSION_USE_SSE
+#endif
+
+namespace TinyMinecraft {
+
+  namespace Geometry {
+
+    namespace {
+
+      // boxes closer than this are treated as crossing the near plane
+      constexpr float MIN_DEPTH = 0.1f;
+
+      auto Cross(const glm::vec2 &o, const glm::vec2 &a, const glm::vec2 &b) -> float {
+        return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+      }
+
+      // Andrew's monotone chain, counter-clockwise; returns the number of hull points written
+      template <size_t N>
+      auto ComputeConvexHull(std::array<glm::vec2, N> points, int count, std::array<glm::vec2, 2 * N> &hull) -> int {
+        std::sort(points.begin(), points.begin() + count, [](const glm::vec2 &a, const glm::vec2 &b) {
+          return a.x < b.x || (a.x == b.x && a.y < b.y);
+        });
+
+        int hullCount = 0;
+        for (int i = 0; i < count; ++i) {
+          while (hullCount >= 2 && Cross(hull[hullCount - 2], hull[hullCount - 1], points[i]) <= 0.0f) --hullCount;
+          hull[hullCount++] = points[i];
+        }
+
+        const int lowerCount = hullCount + 1;
+        for (int i = count - 2; i >= 0; --i) {
+          while (hullCount >= lowerCount && Cross(hull[hullCount - 2], hull[hullCount - 1], points[i]) <= 0.0f) --hullCount;
+          hull[hullCount++] = points[i];
+        }
+
+        // the last point repeats the first
+        return hullCount - 1;
+      }
+
+    }
+
+    void OcclusionBuffer::Clear(const glm::mat4 &viewProjection) {
+      m_viewProjection = viewProjection;
+      m_depth.fill(std::numeric_limits<float>::max());
+    }
+
+    auto OcclusionBuffer::Project(const glm::vec3 &min, const glm::vec3 &max, bool clipToNearPlane, ProjectedBox &box) const -> bool {
+      std::array<glm::vec4, 8> corners;
+      for (int i = 0; i < 8; ++i) {
+        corners[i] = m_viewProjection * glm::vec4(i & 1 ? max.x : min.x, i & 2 ? max.y : min.y, i & 4 ? max.z : min.z, 1.0f);
+      }
+
+      box.pointCount = 0;
+      box.min = glm::vec2(std::numeric_limits<float>::max());
+      box.max = glm::vec2(std::numeric_limits<float>::lowest());
+      box.nearDepth = std::numeric_limits<float>::max();
+      box.farDepth = 0.0f;
+
+      const auto addPoint = [&](const glm::vec4 &clip) {
+        const glm::vec2 ndc = glm::vec2(clip.x, clip.y) / clip.w;
+        const glm::vec2 point((ndc.x * 0.5f + 0.5f) * WIDTH, (ndc.y * 0.5f + 0.5f) * HEIGHT);
+
+        box.points[box.pointCount++] = point;
+        box.min = glm::min(box.min, point);
+        box.max = glm::max(box.max, point);
+        box.nearDepth = std::min(box.nearDepth, clip.w);
+        box.farDepth = std::max(box.farDepth, clip.w);
+      };
+
+      for (int i = 0; i < 8; ++i) {
+        if (corners[i].w >= MIN_DEPTH) {
+          addPoint(corners[i]);
+        } else if (!clipToNearPlane) {
+          return false;
+        }
+      }
+
+      if (box.pointCount < 8) {
+        // edges connect corners whose indices differ in one bit
+        for (int i = 0; i < 8; ++i) {
+          for (int bit = 1; bit < 8; bit <<= 1) {
+            const int j = i | bit;
+            if (j == i || (corners[i].w < MIN_DEPTH) == (corners[j].w < MIN_DEPTH)) {
+              continue;
+            }
+
+            const float t = (MIN_DEPTH - corners[i].w) / (corners[j].w - corners[i].w);
+            addPoint(corners[i] + (corners[j] - corners[i]) * t);
+          }
+        }
+      }
+
+      return box.pointCount >= 3;
+    }
+
+    void OcclusionBuffer::AddOccluder(const glm::vec3 &min, const glm::vec3 &max) {
+      ProjectedBox box;
+      if (!Project(min, max, true, box)) {
+        return;
+      }
+
+      // only pixels entirely inside the silhouette are written
+      const int x0 = std::max(0, static_cast<int>(std::ceil(box.min.x)));
+      const int y0 = std::max(0, static_cast<int>(std::ceil(box.min.y)));
+      const int x1 = std::min(WIDTH, static_cast<int>(std::floor(box.max.x)));
+      const int y1 = std::min(HEIGHT, static_cast<int>(std::floor(box.max.y)));
+
+      if (x0 >= x1 || y0 >= y1) {
+        return;
+      }
+
+      std::array<glm::vec2, 2 * MAX_PROJECTED_POINTS> hull;
+      const int edgeCount = ComputeConvexHull(box.points, box.pointCount, hull);
+      if (edgeCount < 3) {
+        return;
+      }
+
+      // edge functions a * x + b * y + c, offset so that they are >= 0 when the whole pixel at (x, y) is inside
+      std::array<float, 2 * MAX_PROJECTED_POINTS> a, b, c;
+      for (int i = 0; i < edgeCount; ++i) {
+        const glm::vec2 &p0 = hull[i];
+        const glm::vec2 &p1 = hull[(i + 1) % edgeCount];
+
+        a[i] = p0.y - p1.y;
+        b[i] = p1.x - p0.x;
+        c[i] = -(a[i] * p0.x + b[i] * p0.y) + 0.5f * (a[i] + b[i]) - 0.5f * (std::abs(a[i]) + std::abs(b[i]));
+      }
+
+      // lanes outside [x0, x1) fail the edge tests since the hull lies within the bounds
+      const int startX = x0 & ~3;
+
+      for (int y = y0; y < y1; ++y) {
+        float *row = &m_depth[y * WIDTH];
+
+#ifdef OCCLUSION_USE_SSE
+        const __m128 farDepth = _mm_set1_ps(box.farDepth);
+
+        // edge values of the first 4 pixels of the row, stepped by 4 pixels at a time
+        __m128 edges[2 * MAX_PROJECTED_POINTS], steps[2 * MAX_PROJECTED_POINTS];
+        const __m128 xs = _mm_setr_ps(startX, startX + 1.0f, startX + 2.0f, startX + 3.0f);
+        for (int i = 0; i < edgeCount; ++i) {
+          edges[i] = _mm_add_ps(_mm_mul_ps(xs, _mm_set1_ps(a[i])), _mm_set1_ps(b[i] * y + c[i]));
+          steps[i] = _mm_set1_ps(a[i] * 4.0f);
+        }
+
+        for (int x = startX; x < x1; x += 4) {
+          __m128 inside = _mm_cmpge_ps(edges[0], _mm_setzero_ps());
+          edges[0] = _mm_add_ps(edges[0], steps[0]);
+
+          for (int i = 1; i < edgeCount; ++i) {
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(edges[i], _mm_setzero_ps()));
+            edges[i] = _mm_add_ps(edges[i], steps[i]);
+          }
+
+          if (_mm_movemask_ps(inside) == 0) {
+            continue;
+          }
+
+          const __m128 depth = _mm_load_ps(row + x);
+          const __m128 nearer = _mm_min_ps(depth, farDepth);
+          _mm_store_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearer), _mm_andnot_ps(inside, depth)));
+        }
+#else
+        for (int x = x0; x < x1; ++x) {
+          bool inside = true;
+          for (int i = 0; i < edgeCount && inside; ++i) {
+            inside = a[i] * x + b[i] * y + c[i] >= 0.0f;
+          }
+
+          if (inside) {
+            row[x] = std::min(row[x], box.farDepth);
+          }
+        }
+#endif
+      }
+    }
+
+    auto OcclusionBuffer::IsBoxVisible(const glm::vec3 &min, const glm::vec3 &max) const -> bool {
+      ProjectedBox box;
+      if (!Project(min, max, false, box)) {
+        return true;
+      }
+
+      // every pixel the box touches, even partially
+      const int x0 = std::max(0, static_cast<int>(std::floor(box.min.x)));
+      const int y0 = std::max(0, static_cast<int>(std::floor(box.min.y)));
+      const int x1 = std::min(WIDTH - 1, static_cast<int>(std::floor(box.max.x)));
+      const int y1 = std::min(HEIGHT - 1, static_cast<int>(std::floor(box.max.y)));
+
+      if (x0 > x1 || y0 > y1) {
+        return false;
+      }
+
+      for (int y = y0; y <= y1; ++y) {
+        const float *row = &m_depth[y * WIDTH];
+
+#ifdef OCCLUSION_USE_SSE
+        // testing a few extra pixels at both ends of the row can only make the box more visible
+        const __m128 nearDepth = _mm_set1_ps(box.nearDepth);
+        for (int x = x0 & ~3; x <= x1; x += 4) {
+          if (_mm_movemask_ps(_mm_cmpge_ps(_mm_load_ps(row + x), nearDepth)) != 0) {
+            return true;
+          }
+        }
+#else
+        for (int x = x0; x <= x1; ++x) {
+          if (row[x] >= box.nearDepth) {
+            return true;
+          }
+        }
+#endif
+      }
+
+      return false;
+    }
+
+  }
+
+}
@@ -27,6 +27,18 @@ namespace TinyMinecraft {
       return { 0, 0, 0 };
     }
 
+    auto GetOppositeFace(Face face) -> Face {
+      switch (face) {
+        case Face::Top: return Face::Bottom;
+        case Face::Bottom: return Face::Top;
+        case Face::East: return Face::West;
+        case Face::West: return Face::East;
+        case Face::North: return Face::South;
+        case Face::South: return Face::North;
+        default: return Face::None;
+      }
+    }
+
     auto GetVertices(Face face, float width, float height) -> std::array<glm::vec3, 4> {
       switch (face) {
         case Face::Top:
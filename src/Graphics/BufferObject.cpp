@@ -14,17 +14,20 @@ namespace TinyMinecraft {
 
     BufferObject::~BufferObject() {
       glDeleteBuffers(1, &m_handle);
+      Utils::MemoryTracker::Release(Utils::MemoryCategory::GpuBuffers, m_size);
     }
 
     BufferObject::BufferObject(BufferObject &&other) noexcept
       : m_handle(std::exchange(other.m_handle, 0))
       , m_target(other.m_target)
+      , m_size(std::exchange(other.m_size, 0))
     {}
 
     auto BufferObject::operator=(BufferObject &&other) noexcept -> BufferObject & {
       BufferObject temp(std::move(other));
       std::swap(m_handle, temp.m_handle);
       std::swap(m_target, temp.m_target);
+      std::swap(m_size, temp.m_size);
 
       return *this;
     }
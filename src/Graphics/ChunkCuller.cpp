@@ -0,0 +1,206 @@
+#include "Graphics/ChunkCuller.h"
+
+#include "Utils/Profiler.h"
+#include "Utils/utils.h"
+#include <algorithm>
+
+namespace TinyMinecraft {
+
+  namespace Graphics {
+
+    ChunkCuller::ChunkCuller() {
+    #ifdef GFX_DepthOcclusionCulling
+      m_thread = std::thread(&ChunkCuller::RunOcclusionThread, this);
+    #endif
+    }
+
+    ChunkCuller::~ChunkCuller() {
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shouldTerminate = true;
+      }
+      m_condition.notify_all();
+
+      if (m_thread.joinable()) {
+        m_thread.join();
+      }
+    }
+
+    void ChunkCuller::Begin(const std::vector<World::Chunk *> &chunks, const std::vector<World::ChunkVisibility> &visibility, const Geometry::BoundingBoxes &bounds, const glm::mat4 &viewProjection, const glm::vec3 &cameraPos) {
+      PROFILE_FUNCTION(Graphics)
+
+      m_stats = RenderStats{};
+      m_viewProjection = viewProjection;
+      m_cameraPos = cameraPos;
+
+      const Geometry::Frustum frustum(viewProjection);
+      frustum.CullBoxes(bounds, m_chunkVisibility);
+
+      m_frustumChunks.clear();
+      m_frustumVisibility.clear();
+      m_frustumIndices.clear();
+      for (size_t i = 0; i < chunks.size(); ++i) {
+        if (m_chunkVisibility[i]) {
+          m_frustumChunks.push_back(chunks[i]);
+          m_frustumVisibility.push_back(visibility[i]);
+          m_frustumIndices.push_back(i);
+        }
+      }
+
+      m_stats.culledChunks = chunks.size() - m_frustumChunks.size();
+
+    #ifdef GFX_SectionOcclusionCulling
+      // over every chunk, the walk can lead through the empty sections of chunks whose blocks are all outside
+      // the frustum, like those of a valley below the view; it tests each section against the frustum itself
+      m_sectionVisibility.Compute(chunks, visibility, cameraPos, frustum);
+
+      // relative to every loaded section, so it includes the sections removed by frustum culling
+      const size_t sectionCount = chunks.size() * CHUNK_SECTION_COUNT;
+      if (sectionCount > 0) {
+        m_stats.culledSectionFraction = 1.0f - static_cast<float>(m_sectionVisibility.GetVisibleSectionCount()) / sectionCount;
+      }
+    #endif
+
+    #ifdef GFX_DepthOcclusionCulling
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_hasWork = true;
+      }
+      m_condition.notify_one();
+    #endif
+    }
+
+    void ChunkCuller::Finish() {
+      PROFILE_FUNCTION(Graphics)
+
+    #ifdef GFX_DepthOcclusionCulling
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait(lock, [this] { return !m_hasWork; });
+      }
+    #endif
+
+      m_visibleChunks.clear();
+
+      for (size_t i = 0; i < m_frustumChunks.size(); ++i) {
+      #ifdef GFX_SectionOcclusionCulling
+        if (!m_sectionVisibility.IsChunkVisible(m_frustumIndices[i])) {
+          ++m_stats.occludedChunks;
+          continue;
+        }
+      #endif
+
+      #ifdef GFX_DepthOcclusionCulling
+        if (!m_chunkUnoccluded[i]) {
+          ++m_stats.hiddenChunks;
+          continue;
+        }
+      #endif
+
+        m_visibleChunks.push_back(m_frustumChunks[i]);
+      }
+
+      m_stats.drawnChunks = m_visibleChunks.size();
+    }
+
+    auto ChunkCuller::IsSectionReachable(size_t chunkIndex, int section) const -> bool {
+    #ifdef GFX_SectionOcclusionCulling
+      return m_sectionVisibility.IsSectionVisible(m_frustumIndices[chunkIndex], section);
+    #else
+      return true;
+    #endif
+    }
+
+    void ChunkCuller::RunOcclusionThread() {
+      Utils::SetThreadName("occlusion");
+
+      while (true) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait(lock, [this] { return m_hasWork || m_shouldTerminate; });
+
+        if (m_shouldTerminate) {
+          return;
+        }
+
+        lock.unlock();
+        CullHiddenChunks();
+        lock.lock();
+
+        m_hasWork = false;
+        lock.unlock();
+        m_condition.notify_all();
+      }
+    }
+
+    void ChunkCuller::CullHiddenChunks() {
+      PROFILE_FUNCTION(Graphics)
+
+      m_occluders.clear();
+      m_chunkUnoccluded.assign(m_frustumChunks.size(), true);
+
+      // Sections without any connectivity are opaque from every side. Reachable ones are the outermost layer of
+      // the terrain, which is what hides the rest; vertical runs of them are merged into a single box.
+      for (size_t i = 0; i < m_frustumChunks.size(); ++i) {
+        const World::Chunk *chunk = m_frustumChunks[i];
+        const World::ChunkVisibility &visibility = m_frustumVisibility[i];
+        const glm::vec3 origin(chunk->GetChunkPos().x * CHUNK_WIDTH, 0.0f, chunk->GetChunkPos().y * CHUNK_LENGTH);
+
+        for (int section = 0; section < CHUNK_SECTION_COUNT;) {
+          if (visibility.connectivity[section] != 0 || !IsSectionReachable(i, section)) {
+            ++section;
+            continue;
+          }
+
+          int end = section + 1;
+          while (end < CHUNK_SECTION_COUNT && visibility.connectivity[end] == 0) {
+            ++end;
+          }
+
+          const glm::vec3 min = origin + glm::vec3(0.0f, section * CHUNK_SECTION_HEIGHT, 0.0f);
+          const glm::vec3 max = origin + glm::vec3(CHUNK_WIDTH, end * CHUNK_SECTION_HEIGHT, CHUNK_LENGTH);
+          m_occluders.push_back(Occluder{ min, max, glm::distance(m_cameraPos, glm::clamp(m_cameraPos, min, max)) });
+
+          section = end;
+        }
+      }
+
+      if (m_occluders.size() > MAX_OCCLUDERS) {
+        std::ranges::nth_element(m_occluders, m_occluders.begin() + MAX_OCCLUDERS, {}, &Occluder::distance);
+        m_occluders.resize(MAX_OCCLUDERS);
+      }
+
+      // front to back, so occluders hidden by nearer ones can be skipped
+      std::ranges::sort(m_occluders, {}, &Occluder::distance);
+
+      m_occlusionBuffer.Clear(m_viewProjection);
+      for (const Occluder &occluder : m_occluders) {
+        if (m_occlusionBuffer.IsBoxVisible(occluder.min, occluder.max)) {
+          m_occlusionBuffer.AddOccluder(occluder.min, occluder.max);
+        }
+      }
+
+      for (size_t i = 0; i < m_frustumChunks.size(); ++i) {
+        const World::Chunk *chunk = m_frustumChunks[i];
+        const World::ChunkVisibility &visibility = m_frustumVisibility[i];
+        const glm::vec3 origin(chunk->GetChunkPos().x * CHUNK_WIDTH, 0.0f, chunk->GetChunkPos().y * CHUNK_LENGTH);
+
+        bool visible = false;
+
+        // sections above or below the blocks have nothing to draw
+        for (int section = visibility.minHeight / CHUNK_SECTION_HEIGHT; section <= visibility.maxHeight / CHUNK_SECTION_HEIGHT && !visible; ++section) {
+          if (!IsSectionReachable(i, section)) {
+            continue;
+          }
+
+          const glm::vec3 min = origin + glm::vec3(0.0f, section * CHUNK_SECTION_HEIGHT, 0.0f);
+          const glm::vec3 max = origin + glm::vec3(CHUNK_WIDTH, (section + 1) * CHUNK_SECTION_HEIGHT, CHUNK_LENGTH);
+          visible = m_occlusionBuffer.IsBoxVisible(min, max);
+        }
+
+        m_chunkUnoccluded[i] = visible;
+      }
+    }
+
+  }
+
+}
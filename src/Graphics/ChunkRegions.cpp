@@ -0,0 +1,222 @@
+#include "Graphics/ChunkRegions.h"
+
+#include "Graphics/RenderState.h"
+#include "Utils/Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace TinyMinecraft {
+
+  namespace Graphics {
+
+    ChunkRegions::Region::Region(const glm::ivec2 &regionPos)
+      : origin(regionPos * REGION_SIZE)
+      , vbo(GL_ARRAY_BUFFER)
+      , ebo(GL_ELEMENT_ARRAY_BUFFER)
+      , vertices(INITIAL_VERTEX_CAPACITY)
+      , indices(INITIAL_INDEX_CAPACITY)
+    {
+      vao.Bind();
+
+      vbo.Allocate(static_cast<GLsizeiptr>(sizeof(Geometry::MeshVertex)) * INITIAL_VERTEX_CAPACITY, GL_DYNAMIC_DRAW);
+      ebo.Allocate(static_cast<GLsizeiptr>(sizeof(GLuint)) * INITIAL_INDEX_CAPACITY, GL_DYNAMIC_DRAW);
+
+      vbo.Bind();
+      Geometry::Mesh::AddVertexAttributes(vao);
+    }
+
+    ChunkRegions::ChunkRegions()
+      : m_staging(GL_COPY_READ_BUFFER, STAGING_CAPACITY)
+    {}
+
+    void ChunkRegions::Region::Grow(uint32_t vertexCapacity, uint32_t indexCapacity) {
+      PROFILE_FUNCTION(Graphics)
+
+      // copies the old contents into a larger buffer; the vao must be bound so the new index buffer attaches to it
+      const auto grow = [](BufferObject &buffer, GLenum target, GLsizeiptr oldSize, GLsizeiptr newSize) {
+        BufferObject grown(target);
+        grown.Allocate(newSize, GL_DYNAMIC_DRAW);
+
+        glBindBuffer(GL_COPY_READ_BUFFER, buffer.GetHandle());
+        glBindBuffer(GL_COPY_WRITE_BUFFER, grown.GetHandle());
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, oldSize);
+
+        buffer = std::move(grown);
+      };
+
+      vao.Bind();
+
+      if (vertexCapacity > vertices.GetCapacity()) {
+        constexpr auto stride = static_cast<GLsizeiptr>(sizeof(Geometry::MeshVertex));
+        grow(vbo, GL_ARRAY_BUFFER, stride * vertices.GetCapacity(), stride * vertexCapacity);
+        vertices.Grow(vertexCapacity);
+
+        vbo.Bind();
+        Geometry::Mesh::AddVertexAttributes(vao);
+      }
+
+      if (indexCapacity > indices.GetCapacity()) {
+        constexpr auto stride = static_cast<GLsizeiptr>(sizeof(GLuint));
+        grow(ebo, GL_ELEMENT_ARRAY_BUFFER, stride * indices.GetCapacity(), stride * indexCapacity);
+        indices.Grow(indexCapacity);
+
+        ebo.Bind();
+      }
+    }
+
+    void ChunkRegions::Upload(World::Chunk *chunk, const World::ChunkMesh &mesh) {
+      PROFILE_FUNCTION(Graphics)
+
+      if (mesh.indices.empty()) {
+        Remove(chunk);
+        return;
+      }
+
+      const glm::ivec2 chunkPos = chunk->GetChunkPos();
+      const glm::ivec2 regionPos = GetRegionPos(chunkPos);
+
+      auto allocationIt = m_allocations.find(chunk);
+      if (allocationIt != m_allocations.end()) {
+        Free(allocationIt->second);
+        m_allocations.erase(allocationIt);
+      }
+
+      std::unique_ptr<Region> &region = m_regions[regionPos];
+      if (!region) {
+        region = std::make_unique<Region>(regionPos);
+      }
+
+      const auto vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+      const auto indexCount = static_cast<uint32_t>(mesh.indices.size());
+
+      std::optional<uint32_t> vertexOffset = region->vertices.Allocate(vertexCount);
+      std::optional<uint32_t> indexOffset = region->indices.Allocate(indexCount);
+
+      while (!vertexOffset || !indexOffset) {
+        region->Grow(
+          vertexOffset ? region->vertices.GetCapacity() : region->vertices.GetCapacity() * 2,
+          indexOffset ? region->indices.GetCapacity() : region->indices.GetCapacity() * 2
+        );
+
+        if (!vertexOffset) vertexOffset = region->vertices.Allocate(vertexCount);
+        if (!indexOffset) indexOffset = region->indices.Allocate(indexCount);
+      }
+
+      const glm::ivec2 chunkOffset = (chunkPos - region->origin) * glm::ivec2(CHUNK_WIDTH, CHUNK_LENGTH);
+      const glm::vec3 offset(chunkOffset.x, 0.0f, chunkOffset.y);
+
+      Stage<Geometry::MeshVertex>(region->vbo, *vertexOffset, mesh.vertices.size(), [&](size_t begin, size_t count, Geometry::MeshVertex *out) {
+        for (size_t i = 0; i < count; ++i) {
+          out[i] = mesh.vertices[begin + i];
+          out[i].position += offset;
+        }
+      });
+
+      Stage<GLuint>(region->ebo, *indexOffset, mesh.indices.size(), [&](size_t begin, size_t count, GLuint *out) {
+        std::memcpy(out, mesh.indices.data() + begin, sizeof(GLuint) * count);
+      });
+
+      ++region->chunkCount;
+      m_allocations[chunk] = Allocation{ region.get(), *vertexOffset, vertexCount, *indexOffset, indexCount };
+    }
+
+    template <typename T, typename Write>
+    void ChunkRegions::Stage(const BufferObject &destination, uint32_t first, size_t count, Write &&write) {
+      const size_t pieceSize = static_cast<size_t>(m_staging.GetCapacity()) / sizeof(T);
+
+      for (size_t begin = 0; begin < count; begin += pieceSize) {
+        const size_t pieceCount = std::min(pieceSize, count - begin);
+        const auto size = static_cast<GLsizeiptr>(sizeof(T) * pieceCount);
+
+        write(begin, pieceCount, static_cast<T *>(m_staging.Map(size, sizeof(T))));
+        m_staging.Unmap();
+
+        // the copy targets leave the vao's element buffer alone
+        glBindBuffer(GL_COPY_WRITE_BUFFER, destination.GetHandle());
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, m_staging.GetMappedOffset(), static_cast<GLintptr>(sizeof(T) * (first + begin)), size);
+        RenderState::CountBufferUpload();
+      }
+    }
+
+    void ChunkRegions::Remove(World::Chunk *chunk) {
+      const auto it = m_allocations.find(chunk);
+      if (it == m_allocations.end()) {
+        return;
+      }
+
+      Free(it->second);
+      m_allocations.erase(it);
+    }
+
+    void ChunkRegions::Free(const Allocation &allocation) {
+      Region *region = allocation.region;
+
+      region->vertices.Free(allocation.vertexOffset, allocation.vertexCount);
+      region->indices.Free(allocation.indexOffset, allocation.indexCount);
+
+      // no chunk left, give the buffers back
+      if (--region->chunkCount == 0) {
+        m_regions.erase(GetRegionPos(region->origin));
+      }
+    }
+
+    void ChunkRegions::Draw(const std::vector<World::Chunk *> &chunks, Shader &shader) {
+      PROFILE_FUNCTION(Graphics)
+
+      for (World::Chunk *chunk : chunks) {
+        const auto it = m_allocations.find(chunk);
+        if (it == m_allocations.end()) {
+          continue;
+        }
+
+        const Allocation &allocation = it->second;
+        Region *region = allocation.region;
+
+        if (region->counts.empty()) {
+          m_drawnRegions.push_back(region);
+        }
+
+        region->counts.push_back(static_cast<GLsizei>(allocation.indexCount));
+        region->offsets.push_back(reinterpret_cast<const void *>(sizeof(GLuint) * allocation.indexOffset));
+        region->baseVertices.push_back(static_cast<GLint>(allocation.vertexOffset));
+      }
+
+      shader.Use();
+      const GLint modelLocation = shader.GetUniformLocation("uModel");
+
+      for (Region *region : m_drawnRegions) {
+        glm::mat4 model { 1.0f };
+        model = glm::translate(model, glm::vec3(region->origin.x * CHUNK_WIDTH, 0.0f, region->origin.y * CHUNK_LENGTH));
+        shader.Uniform(modelLocation, model);
+
+        region->vao.Bind();
+        glMultiDrawElementsBaseVertex(
+          GL_TRIANGLES,
+          region->counts.data(),
+          GL_UNSIGNED_INT,
+          region->offsets.data(),
+          static_cast<GLsizei>(region->counts.size()),
+          region->baseVertices.data()
+        );
+        RenderState::CountDrawCall();
+
+        region->counts.clear();
+        region->offsets.clear();
+        region->baseVertices.clear();
+      }
+
+      m_drawCallCount = m_drawnRegions.size();
+      m_drawnRegions.clear();
+    }
+
+    auto ChunkRegions::GetRegionPos(const glm::ivec2 &chunkPos) -> glm::ivec2 {
+      return glm::ivec2(
+        static_cast<int>(std::floor(static_cast<float>(chunkPos.x) / REGION_SIZE)),
+        static_cast<int>(std::floor(static_cast<float>(chunkPos.y) / REGION_SIZE))
+      );
+    }
+
+  }
+
+}
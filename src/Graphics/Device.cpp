@@ -0,0 +1,259 @@
+#include "Graphics/Device.h"
+
+#include "Graphics/NullDevice.h"
+
+namespace TinyMinecraft {
+
+  namespace Graphics {
+
+    static struct DeviceData {
+      DeviceBackend backend = DeviceBackend::OpenGL;
+      Device::FrameStats currentFrame, lastFrame;
+      uint64_t frameCount = 0;
+
+      // the loaded functions, called by the recording wrappers
+      struct {
+        PFNGLDRAWARRAYSPROC drawArrays;
+        PFNGLDRAWELEMENTSPROC drawElements;
+        PFNGLDRAWELEMENTSBASEVERTEXPROC drawElementsBaseVertex;
+        PFNGLMULTIDRAWELEMENTSBASEVERTEXPROC multiDrawElementsBaseVertex;
+
+        PFNGLBUFFERDATAPROC bufferData;
+        PFNGLBUFFERSUBDATAPROC bufferSubData;
+        PFNGLMAPBUFFERRANGEPROC mapBufferRange;
+        PFNGLCOPYBUFFERSUBDATAPROC copyBufferSubData;
+      #ifdef GL_ARB_buffer_storage
+        PFNGLBUFFERSTORAGEPROC bufferStorage;
+      #endif
+
+        PFNGLUSEPROGRAMPROC useProgram;
+        PFNGLBINDVERTEXARRAYPROC bindVertexArray;
+        PFNGLBINDBUFFERPROC bindBuffer;
+        PFNGLBINDBUFFERBASEPROC bindBufferBase;
+        PFNGLACTIVETEXTUREPROC activeTexture;
+        PFNGLBINDTEXTUREPROC bindTexture;
+        PFNGLENABLEPROC enable;
+        PFNGLDISABLEPROC disable;
+        PFNGLDEPTHMASKPROC depthMask;
+        PFNGLBLENDFUNCPROC blendFunc;
+        PFNGLCULLFACEPROC cullFace;
+        PFNGLFRONTFACEPROC frontFace;
+        PFNGLPOLYGONMODEPROC polygonMode;
+      } gl {};
+    } s_data;
+
+    namespace {
+
+      //// DRAWS ////
+
+      void APIENTRY DrawArrays(GLenum mode, GLint first, GLsizei count) {
+        ++s_data.currentFrame.drawCalls;
+        s_data.gl.drawArrays(mode, first, count);
+      }
+
+      void APIENTRY DrawElements(GLenum mode, GLsizei count, GLenum type, const void *indices) {
+        ++s_data.currentFrame.drawCalls;
+        s_data.gl.drawElements(mode, count, type, indices);
+      }
+
+      void APIENTRY DrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, const void *indices, GLint baseVertex) {
+        ++s_data.currentFrame.drawCalls;
+        s_data.gl.drawElementsBaseVertex(mode, count, type, indices, baseVertex);
+      }
+
+      void APIENTRY MultiDrawElementsBaseVertex(GLenum mode, const GLsizei *count, GLenum type, const void *const *indices, GLsizei drawCount, const GLint *baseVertex) {
+        ++s_data.currentFrame.drawCalls;
+        s_data.gl.multiDrawElementsBaseVertex(mode, count, type, indices, drawCount, baseVertex);
+      }
+
+      //// BUFFERS ////
+
+      void CountAllocation(GLsizeiptr size, const void *data) {
+        ++s_data.currentFrame.bufferAllocations;
+        s_data.currentFrame.allocatedBytes += static_cast<size_t>(size);
+
+        if (data != nullptr) {
+          s_data.currentFrame.uploadedBytes += static_cast<size_t>(size);
+        }
+      }
+
+      void APIENTRY BufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usage) {
+        CountAllocation(size, data);
+        s_data.gl.bufferData(target, size, data, usage);
+      }
+
+    #ifdef GL_ARB_buffer_storage
+      void APIENTRY BufferStorage(GLenum target, GLsizeiptr size, const void *data, GLbitfield flags) {
+        CountAllocation(size, data);
+        s_data.gl.bufferStorage(target, size, data, flags);
+      }
+    #endif
+
+      void APIENTRY BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void *data) {
+        s_data.currentFrame.uploadedBytes += static_cast<size_t>(size);
+        s_data.gl.bufferSubData(target, offset, size, data);
+      }
+
+      void *APIENTRY MapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access) {
+        if ((access & GL_MAP_WRITE_BIT) != 0) {
+          s_data.currentFrame.uploadedBytes += static_cast<size_t>(length);
+        }
+        return s_data.gl.mapBufferRange(target, offset, length, access);
+      }
+
+      void APIENTRY CopyBufferSubData(GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size) {
+        s_data.currentFrame.copiedBytes += static_cast<size_t>(size);
+        s_data.gl.copyBufferSubData(readTarget, writeTarget, readOffset, writeOffset, size);
+      }
+
+      //// STATE ////
+
+      void APIENTRY UseProgram(GLuint program) {
+        ++s_data.currentFrame.stateChanges;
+        s_data.gl.useProgram(program);
+      }
+
+      void APIENTRY BindVertexArray(GLuint vertexArray) {
+        ++s_data.currentFrame.stateChanges;
+        s_data.gl.bindVertexArray(vertexArray);
+      }
+
+      void APIENTRY BindBuffer(GLenum target, GLuint buffer) {
+        ++s_data.currentFrame.stateChanges;
+        s_data.gl.bindBuffer(target, buffer);
+      }
+
+      void APIENTRY BindBufferBase(GLenum target, GLuint index, GLuint buffer) {
+        ++s_data.currentFrame.stateChanges;
+        s_data.gl.bindBufferBase(target, index, buffer);
+      }
+
+      void APIENTRY ActiveTexture(GLenum unit) {
+        ++s_data.currentFrame.stateChanges;
+        s_data.gl.activeTexture(unit);
+      }
+
+      void APIENTRY BindTexture(GLenum target, GLuint texture) {
+        ++s_data.currentFrame.stateChanges;
+        s_data.gl.bindTexture(target, texture);
+      }
+
+      void APIENTRY Enable(GLenum capability) {
+        ++s_data.currentFrame.stateChanges;
+        s_data.gl.enable(capability);
+      }
+
+      void APIENTRY Disable(GLenum capability) {
+        ++s_data.currentFrame.stateChanges;
+        s_data.gl.disable(capability);
+      }
+
+      void APIENTRY DepthMask(GLboolean flag) {
+        ++s_data.currentFrame.stateChanges;
+        s_data.gl.depthMask(flag);
+      }
+
+      void APIENTRY BlendFunc(GLenum source, GLenum destination) {
+        ++s_data.currentFrame.stateChanges;
+        s_data.gl.blendFunc(source, destination);
+      }
+
+      void APIENTRY CullFace(GLenum mode) {
+        ++s_data.currentFrame.stateChanges;
+        s_data.gl.cullFace(mode);
+      }
+
+      void APIENTRY FrontFace(GLenum mode) {
+        ++s_data.currentFrame.stateChanges;
+        s_data.gl.frontFace(mode);
+      }
+
+      void APIENTRY PolygonMode(GLenum face, GLenum mode) {
+        ++s_data.currentFrame.stateChanges;
+        s_data.gl.polygonMode(face, mode);
+      }
+
+      // keeps the loaded function in `saved` and routes calls through `wrapper`; functions the context does
+      // not have stay null
+      template <typename Proc>
+      void Hook(Proc &loaded, Proc &saved, Proc wrapper) {
+        saved = loaded;
+        if (loaded != nullptr) {
+          loaded = wrapper;
+        }
+      }
+
+      void HookFunctions() {
+        Hook(glad_glDrawArrays, s_data.gl.drawArrays, &DrawArrays);
+        Hook(glad_glDrawElements, s_data.gl.drawElements, &DrawElements);
+        Hook(glad_glDrawElementsBaseVertex, s_data.gl.drawElementsBaseVertex, &DrawElementsBaseVertex);
+        Hook(glad_glMultiDrawElementsBaseVertex, s_data.gl.multiDrawElementsBaseVertex, &MultiDrawElementsBaseVertex);
+
+        Hook(glad_glBufferData, s_data.gl.bufferData, &BufferData);
+        Hook(glad_glBufferSubData, s_data.gl.bufferSubData, &BufferSubData);
+        Hook(glad_glMapBufferRange, s_data.gl.mapBufferRange, &MapBufferRange);
+        Hook(glad_glCopyBufferSubData, s_data.gl.copyBufferSubData, &CopyBufferSubData);
+      #ifdef GL_ARB_buffer_storage
+        Hook(glad_glBufferStorage, s_data.gl.bufferStorage, &BufferStorage);
+      #endif
+
+        Hook(glad_glUseProgram, s_data.gl.useProgram, &UseProgram);
+        Hook(glad_glBindVertexArray, s_data.gl.bindVertexArray, &BindVertexArray);
+        Hook(glad_glBindBuffer, s_data.gl.bindBuffer, &BindBuffer);
+        Hook(glad_glBindBufferBase, s_data.gl.bindBufferBase, &BindBufferBase);
+        Hook(glad_glActiveTexture, s_data.gl.activeTexture, &ActiveTexture);
+        Hook(glad_glBindTexture, s_data.gl.bindTexture, &BindTexture);
+        Hook(glad_glEnable, s_data.gl.enable, &Enable);
+        Hook(glad_glDisable, s_data.gl.disable, &Disable);
+        Hook(glad_glDepthMask, s_data.gl.depthMask, &DepthMask);
+        Hook(glad_glBlendFunc, s_data.gl.blendFunc, &BlendFunc);
+        Hook(glad_glCullFace, s_data.gl.cullFace, &CullFace);
+        Hook(glad_glFrontFace, s_data.gl.frontFace, &FrontFace);
+        Hook(glad_glPolygonMode, s_data.gl.polygonMode, &PolygonMode);
+      }
+
+    }
+
+    auto Device::Initialize(DeviceBackend backend, GLADloadproc loader) -> bool {
+      if (backend == DeviceBackend::Null) {
+        loader = &NullDevice::GetProcAddress;
+      }
+
+      if (loader == nullptr || !gladLoadGLLoader(loader)) {
+        return false;
+      }
+
+      s_data.backend = backend;
+
+      if (backend != DeviceBackend::OpenGL) {
+        HookFunctions();
+      }
+
+      return true;
+    }
+
+    auto Device::GetBackend() -> DeviceBackend {
+      return s_data.backend;
+    }
+
+    auto Device::IsRecording() -> bool {
+      return s_data.backend != DeviceBackend::OpenGL;
+    }
+
+    auto Device::GetFrameStats() -> const FrameStats & {
+      return s_data.lastFrame;
+    }
+
+    auto Device::GetFrameCount() -> uint64_t {
+      return s_data.frameCount;
+    }
+
+    void Device::EndFrame() {
+      s_data.lastFrame = s_data.currentFrame;
+      s_data.currentFrame = FrameStats{};
+      ++s_data.frameCount;
+    }
+
+  }
+
+}
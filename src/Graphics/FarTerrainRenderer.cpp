@@ -0,0 +1,191 @@
+#include "Graphics/FarTerrainRenderer.h"
+
+#include "Geometry/Frustum.h"
+#include "Geometry/Mesh.h"
+#include "Graphics/RenderState.h"
+#include "Graphics/Renderer.h"
+#include "Utils/Profiler.h"
+#include <algorithm>
+
+namespace TinyMinecraft {
+
+  namespace Graphics {
+
+    namespace {
+
+      constexpr auto SLOT_BYTES = static_cast<GLsizeiptr>(sizeof(Geometry::MeshVertex) * World::FarTerrain::TILE_VERTEX_COUNT);
+
+    }
+
+    FarTerrainRenderer::FarTerrainRenderer(const Texture &blockAtlas)
+      : m_shader("../resources/shaders/far_terrain.vs", "../resources/shaders/far_terrain.fs")
+      , m_vbo(GL_ARRAY_BUFFER)
+      , m_ebo(GL_ELEMENT_ARRAY_BUFFER)
+    {
+      m_shader.Uniform("uBlockAtlas", static_cast<int>(blockAtlas.GetId()));
+      m_shader.BindUniformBlock("FrameUniforms", Renderer::FRAME_UNIFORMS_BINDING);
+
+      m_vao.Bind();
+      m_ebo.BufferData(World::FarTerrain::GetTileIndices(), GL_STATIC_DRAW);
+    }
+
+    auto FarTerrainRenderer::Update(World::FarTerrain &farTerrain, size_t budget) -> size_t {
+      PROFILE_FUNCTION(Graphics)
+
+      std::shared_ptr<const World::FarTile> tile;
+      while (farTerrain.PollTile(tile)) {
+        if (farTerrain.IsSelected(tile->key)) {
+          m_pendingTiles[tile->key] = std::move(tile);
+        }
+      }
+
+      if (farTerrain.GetSelectionVersion() != m_selectionVersion) {
+        m_selectionVersion = farTerrain.GetSelectionVersion();
+        std::erase_if(m_pendingTiles, [&](const auto &entry) { return !farTerrain.IsSelected(entry.first); });
+        m_hasRetiredTiles = true;
+      }
+
+      size_t uploadedBytes = 0;
+
+      if (budget > 0 && !m_pendingTiles.empty()) {
+        m_uploadOrder.clear();
+        for (const auto &[key, pendingTile] : m_pendingTiles) {
+          m_uploadOrder.push_back(pendingTile);
+        }
+
+        // finest first, they are the closest
+        std::ranges::sort(m_uploadOrder, {}, [](const auto &pendingTile) { return pendingTile->key.level; });
+
+        for (const auto &pendingTile : m_uploadOrder) {
+          const size_t size = pendingTile->GetSizeInBytes();
+
+          if (uploadedBytes > 0 && uploadedBytes + size > budget) {
+            break;
+          }
+
+          Upload(*pendingTile);
+          m_pendingTiles.erase(pendingTile->key);
+          uploadedBytes += size;
+        }
+      }
+
+      if (m_hasRetiredTiles) {
+        RetireTiles(farTerrain);
+      }
+
+      return uploadedBytes;
+    }
+
+    void FarTerrainRenderer::RetireTiles(const World::FarTerrain &farTerrain) {
+      // the old tiles fill the holes until every selected tile is uploaded
+      const bool isComplete = std::ranges::all_of(farTerrain.GetSelection(), [this](const World::FarTileKey &key) {
+        return m_tiles.contains(key);
+      });
+
+      if (!isComplete) {
+        return;
+      }
+
+      for (auto it = m_tiles.begin(); it != m_tiles.end();) {
+        if (farTerrain.IsSelected(it->first)) {
+          ++it;
+          continue;
+        }
+
+        m_freeSlots.push_back(it->second.index);
+        it = m_tiles.erase(it);
+      }
+
+      m_hasRetiredTiles = false;
+    }
+
+    void FarTerrainRenderer::Upload(const World::FarTile &tile) {
+      PROFILE_FUNCTION(Graphics)
+
+      auto it = m_tiles.find(tile.key);
+
+      if (it == m_tiles.end()) {
+        if (m_freeSlots.empty()) {
+          Grow(m_slotCount > 0 ? m_slotCount * 2 : INITIAL_SLOT_COUNT);
+        }
+
+        it = m_tiles.emplace(tile.key, Slot{ m_freeSlots.back(), tile.min, tile.max }).first;
+        m_freeSlots.pop_back();
+      }
+
+      it->second.min = tile.min;
+      it->second.max = tile.max;
+
+      m_vbo.BufferSubData(SLOT_BYTES * it->second.index, tile.vertices);
+      RenderState::CountBufferUpload();
+    }
+
+    void FarTerrainRenderer::Grow(uint32_t slotCount) {
+      PROFILE_FUNCTION(Graphics)
+
+      // copies the old contents into a larger buffer, like ChunkRegions
+      BufferObject grown(GL_ARRAY_BUFFER);
+      grown.Allocate(SLOT_BYTES * slotCount, GL_DYNAMIC_DRAW);
+
+      if (m_slotCount > 0) {
+        glBindBuffer(GL_COPY_READ_BUFFER, m_vbo.GetHandle());
+        glBindBuffer(GL_COPY_WRITE_BUFFER, grown.GetHandle());
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, SLOT_BYTES * m_slotCount);
+      }
+
+      m_vbo = std::move(grown);
+
+      m_vao.Bind();
+      m_vbo.Bind();
+      Geometry::Mesh::AddVertexAttributes(m_vao);
+
+      // handed out lowest first
+      for (uint32_t slot = slotCount; slot > m_slotCount; --slot) {
+        m_freeSlots.push_back(slot - 1);
+      }
+
+      m_slotCount = slotCount;
+    }
+
+    void FarTerrainRenderer::Draw(const glm::mat4 &viewProjection, const glm::vec2 &innerCenter, float innerRadius) {
+      PROFILE_FUNCTION(Graphics)
+
+      const Geometry::Frustum frustum(viewProjection);
+
+      for (const auto &[key, slot] : m_tiles) {
+        if (!frustum.IsBoxVisible(slot.min, slot.max)) {
+          continue;
+        }
+
+        m_counts.push_back(static_cast<GLsizei>(World::FarTerrain::TILE_INDEX_COUNT));
+        m_offsets.push_back(nullptr);
+        m_baseVertices.push_back(static_cast<GLint>(slot.index * World::FarTerrain::TILE_VERTEX_COUNT));
+      }
+
+      if (m_counts.empty()) {
+        return;
+      }
+
+      m_shader.Use();
+      m_shader.Uniform("uInnerCenter", innerCenter);
+      m_shader.Uniform("uInnerRadius", innerRadius);
+
+      m_vao.Bind();
+      glMultiDrawElementsBaseVertex(
+        GL_TRIANGLES,
+        m_counts.data(),
+        GL_UNSIGNED_INT,
+        m_offsets.data(),
+        static_cast<GLsizei>(m_counts.size()),
+        m_baseVertices.data()
+      );
+      RenderState::CountDrawCall();
+
+      m_counts.clear();
+      m_offsets.clear();
+      m_baseVertices.clear();
+    }
+
+  }
+
+}
@@ -0,0 +1,234 @@
+#include "Graphics/NullDevice.h"
+
+#include "Graphics/gfx.h"
+#include <cstddef>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace TinyMinecraft {
+
+  namespace Graphics {
+
+    static struct NullDeviceData {
+      GLuint nextName = 1;
+      std::unordered_map<GLenum, GLuint> boundBuffers;
+      // only buffers that have been mapped get host memory
+      std::unordered_map<GLuint, std::vector<std::byte>> mappedStorage;
+      int fence = 0;
+    } s_data;
+
+    namespace {
+
+      template <typename Proc>
+      struct NoOp;
+
+      template <typename R, typename... Args>
+      struct NoOp<R (APIENTRY *)(Args...)> {
+        static R APIENTRY Call(Args...) { return R(); }
+      };
+
+      // the explicit template argument makes sure `proc` matches the signature glad expects
+      template <typename Proc>
+      auto ToAddress(Proc proc) -> void * {
+        return reinterpret_cast<void *>(proc);
+      }
+
+      template <typename Proc>
+      auto GetNoOp() -> void * {
+        return ToAddress<Proc>(&NoOp<Proc>::Call);
+      }
+
+      const GLubyte *APIENTRY GetString(GLenum name) {
+        switch (name) {
+          case GL_VERSION: return reinterpret_cast<const GLubyte *>("3.3.0 Null");
+          case GL_RENDERER: return reinterpret_cast<const GLubyte *>("Null");
+          default: return reinterpret_cast<const GLubyte *>("");
+        }
+      }
+
+      const GLubyte *APIENTRY GetStringi(GLenum, GLuint) {
+        return reinterpret_cast<const GLubyte *>("");
+      }
+
+      void APIENTRY GetIntegerv(GLenum name, GLint *data) {
+        switch (name) {
+          case GL_MAJOR_VERSION: *data = 3; break;
+          case GL_MINOR_VERSION: *data = 3; break;
+          default: *data = 0; break;
+        }
+      }
+
+      void APIENTRY GetFloatv(GLenum, GLfloat *data) {
+        *data = 0.0f;
+      }
+
+      void APIENTRY GenNames(GLsizei count, GLuint *names) {
+        for (GLsizei i = 0; i < count; ++i) {
+          names[i] = s_data.nextName++;
+        }
+      }
+
+      GLuint APIENTRY CreateProgram() {
+        return s_data.nextName++;
+      }
+
+      GLuint APIENTRY CreateShader(GLenum) {
+        return s_data.nextName++;
+      }
+
+      void APIENTRY GetShaderiv(GLuint, GLenum name, GLint *params) {
+        *params = name == GL_COMPILE_STATUS ? GL_TRUE : 0;
+      }
+
+      void APIENTRY GetProgramiv(GLuint, GLenum name, GLint *params) {
+        *params = name == GL_LINK_STATUS ? GL_TRUE : 0;
+      }
+
+      void APIENTRY GetInfoLog(GLuint, GLsizei size, GLsizei *length, GLchar *log) {
+        if (length != nullptr) *length = 0;
+        if (size > 0) log[0] = '\0';
+      }
+
+      GLint APIENTRY GetUniformLocation(GLuint, const GLchar *) {
+        return -1;
+      }
+
+      GLuint APIENTRY GetUniformBlockIndex(GLuint, const GLchar *) {
+        return GL_INVALID_INDEX;
+      }
+
+      void APIENTRY BindBuffer(GLenum target, GLuint buffer) {
+        s_data.boundBuffers[target] = buffer;
+      }
+
+      void APIENTRY BindBufferBase(GLenum target, GLuint, GLuint buffer) {
+        s_data.boundBuffers[target] = buffer;
+      }
+
+      void APIENTRY DeleteBuffers(GLsizei count, const GLuint *buffers) {
+        for (GLsizei i = 0; i < count; ++i) {
+          s_data.mappedStorage.erase(buffers[i]);
+        }
+      }
+
+      void *APIENTRY MapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield) {
+        std::vector<std::byte> &storage = s_data.mappedStorage[s_data.boundBuffers[target]];
+
+        const auto end = static_cast<size_t>(offset + length);
+        if (storage.size() < end) {
+          storage.resize(end);
+        }
+
+        return storage.data() + offset;
+      }
+
+      GLboolean APIENTRY UnmapBuffer(GLenum) {
+        return GL_TRUE;
+      }
+
+      GLsync APIENTRY FenceSync(GLenum, GLbitfield) {
+        return reinterpret_cast<GLsync>(&s_data.fence);
+      }
+
+      GLenum APIENTRY ClientWaitSync(GLsync, GLbitfield, GLuint64) {
+        return GL_ALREADY_SIGNALED;
+      }
+
+      auto GetProcAddresses() -> const std::unordered_map<std::string_view, void *> & {
+        static const std::unordered_map<std::string_view, void *> procs {
+          // queries
+          { "glGetString", ToAddress<PFNGLGETSTRINGPROC>(GetString) },
+          { "glGetStringi", ToAddress<PFNGLGETSTRINGIPROC>(GetStringi) },
+          { "glGetIntegerv", ToAddress<PFNGLGETINTEGERVPROC>(GetIntegerv) },
+          { "glGetFloatv", ToAddress<PFNGLGETFLOATVPROC>(GetFloatv) },
+          { "glGetShaderiv", ToAddress<PFNGLGETSHADERIVPROC>(GetShaderiv) },
+          { "glGetProgramiv", ToAddress<PFNGLGETPROGRAMIVPROC>(GetProgramiv) },
+          { "glGetShaderInfoLog", ToAddress<PFNGLGETSHADERINFOLOGPROC>(GetInfoLog) },
+          { "glGetProgramInfoLog", ToAddress<PFNGLGETPROGRAMINFOLOGPROC>(GetInfoLog) },
+          { "glGetUniformLocation", ToAddress<PFNGLGETUNIFORMLOCATIONPROC>(GetUniformLocation) },
+          { "glGetUniformBlockIndex", ToAddress<PFNGLGETUNIFORMBLOCKINDEXPROC>(GetUniformBlockIndex) },
+          { "glGetActiveUniform", GetNoOp<PFNGLGETACTIVEUNIFORMPROC>() },
+
+          // objects
+          { "glGenBuffers", ToAddress<PFNGLGENBUFFERSPROC>(GenNames) },
+          { "glGenTextures", ToAddress<PFNGLGENTEXTURESPROC>(GenNames) },
+          { "glGenVertexArrays", ToAddress<PFNGLGENVERTEXARRAYSPROC>(GenNames) },
+          { "glCreateProgram", ToAddress<PFNGLCREATEPROGRAMPROC>(CreateProgram) },
+          { "glCreateShader", ToAddress<PFNGLCREATESHADERPROC>(CreateShader) },
+          { "glDeleteBuffers", ToAddress<PFNGLDELETEBUFFERSPROC>(DeleteBuffers) },
+          { "glDeleteTextures", GetNoOp<PFNGLDELETETEXTURESPROC>() },
+          { "glDeleteVertexArrays", GetNoOp<PFNGLDELETEVERTEXARRAYSPROC>() },
+          { "glDeleteProgram", GetNoOp<PFNGLDELETEPROGRAMPROC>() },
+          { "glDeleteShader", GetNoOp<PFNGLDELETESHADERPROC>() },
+
+          // shaders
+          { "glShaderSource", GetNoOp<PFNGLSHADERSOURCEPROC>() },
+          { "glCompileShader", GetNoOp<PFNGLCOMPILESHADERPROC>() },
+          { "glAttachShader", GetNoOp<PFNGLATTACHSHADERPROC>() },
+          { "glLinkProgram", GetNoOp<PFNGLLINKPROGRAMPROC>() },
+          { "glUseProgram", GetNoOp<PFNGLUSEPROGRAMPROC>() },
+          { "glUniform1f", GetNoOp<PFNGLUNIFORM1FPROC>() },
+          { "glUniform1i", GetNoOp<PFNGLUNIFORM1IPROC>() },
+          { "glUniform2fv", GetNoOp<PFNGLUNIFORM2FVPROC>() },
+          { "glUniform3fv", GetNoOp<PFNGLUNIFORM3FVPROC>() },
+          { "glUniform4fv", GetNoOp<PFNGLUNIFORM4FVPROC>() },
+          { "glUniformMatrix3fv", GetNoOp<PFNGLUNIFORMMATRIX3FVPROC>() },
+          { "glUniformMatrix4fv", GetNoOp<PFNGLUNIFORMMATRIX4FVPROC>() },
+          { "glUniformBlockBinding", GetNoOp<PFNGLUNIFORMBLOCKBINDINGPROC>() },
+
+          // buffers
+          { "glBindBuffer", ToAddress<PFNGLBINDBUFFERPROC>(BindBuffer) },
+          { "glBindBufferBase", ToAddress<PFNGLBINDBUFFERBASEPROC>(BindBufferBase) },
+          { "glBufferData", GetNoOp<PFNGLBUFFERDATAPROC>() },
+          { "glBufferSubData", GetNoOp<PFNGLBUFFERSUBDATAPROC>() },
+          { "glBufferStorage", GetNoOp<PFNGLBUFFERSTORAGEPROC>() },
+          { "glCopyBufferSubData", GetNoOp<PFNGLCOPYBUFFERSUBDATAPROC>() },
+          { "glMapBufferRange", ToAddress<PFNGLMAPBUFFERRANGEPROC>(MapBufferRange) },
+          { "glUnmapBuffer", ToAddress<PFNGLUNMAPBUFFERPROC>(UnmapBuffer) },
+          { "glFenceSync", ToAddress<PFNGLFENCESYNCPROC>(FenceSync) },
+          { "glClientWaitSync", ToAddress<PFNGLCLIENTWAITSYNCPROC>(ClientWaitSync) },
+          { "glDeleteSync", GetNoOp<PFNGLDELETESYNCPROC>() },
+
+          // vertex arrays and textures
+          { "glBindVertexArray", GetNoOp<PFNGLBINDVERTEXARRAYPROC>() },
+          { "glEnableVertexAttribArray", GetNoOp<PFNGLENABLEVERTEXATTRIBARRAYPROC>() },
+          { "glVertexAttribPointer", GetNoOp<PFNGLVERTEXATTRIBPOINTERPROC>() },
+          { "glVertexAttribIPointer", GetNoOp<PFNGLVERTEXATTRIBIPOINTERPROC>() },
+          { "glActiveTexture", GetNoOp<PFNGLACTIVETEXTUREPROC>() },
+          { "glBindTexture", GetNoOp<PFNGLBINDTEXTUREPROC>() },
+          { "glTexImage2D", GetNoOp<PFNGLTEXIMAGE2DPROC>() },
+          { "glTexParameterf", GetNoOp<PFNGLTEXPARAMETERFPROC>() },
+          { "glTexParameteri", GetNoOp<PFNGLTEXPARAMETERIPROC>() },
+          { "glGenerateMipmap", GetNoOp<PFNGLGENERATEMIPMAPPROC>() },
+
+          // state and drawing
+          { "glEnable", GetNoOp<PFNGLENABLEPROC>() },
+          { "glDisable", GetNoOp<PFNGLDISABLEPROC>() },
+          { "glBlendFunc", GetNoOp<PFNGLBLENDFUNCPROC>() },
+          { "glCullFace", GetNoOp<PFNGLCULLFACEPROC>() },
+          { "glFrontFace", GetNoOp<PFNGLFRONTFACEPROC>() },
+          { "glDepthMask", GetNoOp<PFNGLDEPTHMASKPROC>() },
+          { "glPolygonMode", GetNoOp<PFNGLPOLYGONMODEPROC>() },
+          { "glClear", GetNoOp<PFNGLCLEARPROC>() },
+          { "glClearColor", GetNoOp<PFNGLCLEARCOLORPROC>() },
+          { "glDrawArrays", GetNoOp<PFNGLDRAWARRAYSPROC>() },
+          { "glDrawElements", GetNoOp<PFNGLDRAWELEMENTSPROC>() },
+          { "glDrawElementsBaseVertex", GetNoOp<PFNGLDRAWELEMENTSBASEVERTEXPROC>() },
+          { "glMultiDrawElementsBaseVertex", GetNoOp<PFNGLMULTIDRAWELEMENTSBASEVERTEXPROC>() },
+        };
+
+        return procs;
+      }
+
+    }
+
+    auto NullDevice::GetProcAddress(const char *name) -> void * {
+      const auto &procs = GetProcAddresses();
+      const auto it = procs.find(name);
+      return it != procs.end() ? it->second : nullptr;
+    }
+
+  }
+
+}
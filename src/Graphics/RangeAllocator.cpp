@@ -0,0 +1,103 @@
+#include "Graphics/RangeAllocator.h"
+
+#include "Utils/Logger.h"
+#include <algorithm>
+#include <iterator>
+
+namespace TinyMinecraft {
+
+  namespace Graphics {
+
+    RangeAllocator::RangeAllocator(uint32_t capacity)
+      : m_capacity(capacity)
+      , m_freeSize(capacity)
+    {
+      if (capacity > 0) {
+        m_freeRanges.emplace(0, capacity);
+      }
+    }
+
+    auto RangeAllocator::Allocate(uint32_t size) -> std::optional<uint32_t> {
+      if (size == 0 || size > m_freeSize) {
+        return std::nullopt;
+      }
+
+      for (auto it = m_freeRanges.begin(); it != m_freeRanges.end(); ++it) {
+        const auto [offset, freeSize] = *it;
+        if (freeSize < size) {
+          continue;
+        }
+
+        m_freeRanges.erase(it);
+        if (freeSize > size) {
+          m_freeRanges.emplace(offset + size, freeSize - size);
+        }
+
+        m_freeSize -= size;
+        return offset;
+      }
+
+      return std::nullopt;
+    }
+
+    void RangeAllocator::Free(uint32_t offset, uint32_t size) {
+      if (size == 0) {
+        return;
+      }
+
+      if (offset + size > m_capacity) {
+        Utils::Logger::Error("RangeAllocator: freeing [{}, {}) outside of capacity {}", offset, offset + size, m_capacity);
+        exit(1);
+      }
+
+      auto next = m_freeRanges.lower_bound(offset);
+
+      const bool overlapsNext = next != m_freeRanges.end() && next->first < offset + size;
+      const bool overlapsPrevious = next != m_freeRanges.begin() && std::prev(next)->first + std::prev(next)->second > offset;
+
+      if (overlapsNext || overlapsPrevious) {
+        Utils::Logger::Error("RangeAllocator: range [{}, {}) is already free", offset, offset + size);
+        exit(1);
+      }
+
+      m_freeSize += size;
+
+      // merge with the free range right after
+      if (next != m_freeRanges.end() && next->first == offset + size) {
+        size += next->second;
+        next = m_freeRanges.erase(next);
+      }
+
+      // and with the one right before
+      if (next != m_freeRanges.begin()) {
+        const auto previous = std::prev(next);
+        if (previous->first + previous->second == offset) {
+          previous->second += size;
+          return;
+        }
+      }
+
+      m_freeRanges.emplace_hint(next, offset, size);
+    }
+
+    void RangeAllocator::Grow(uint32_t capacity) {
+      if (capacity <= m_capacity) {
+        return;
+      }
+
+      const uint32_t oldCapacity = m_capacity;
+      m_capacity = capacity;
+      Free(oldCapacity, capacity - oldCapacity);
+    }
+
+    auto RangeAllocator::GetLargestFreeRange() const -> uint32_t {
+      uint32_t largest = 0;
+      for (const auto &[offset, size] : m_freeRanges) {
+        largest = std::max(largest, size);
+      }
+      return largest;
+    }
+
+  }
+
+}
@@ -0,0 +1,123 @@
+#include "Graphics/RenderState.h"
+
+#include <array>
+
+namespace TinyMinecraft {
+
+  namespace Graphics {
+
+    // 0 is a valid binding, so unknown state uses a handle GL never returns
+    static constexpr GLuint UNKNOWN = ~0u;
+
+    static constexpr auto MakeUnknownTextures() -> std::array<GLuint, RenderState::MAX_TEXTURE_UNITS> {
+      std::array<GLuint, RenderState::MAX_TEXTURE_UNITS> textures;
+      textures.fill(UNKNOWN);
+      return textures;
+    }
+
+    static struct RenderStateData {
+      GLuint program = UNKNOWN;
+      GLuint vertexArray = UNKNOWN;
+      GLuint activeTextureUnit = UNKNOWN;
+      std::array<GLuint, RenderState::MAX_TEXTURE_UNITS> textures = MakeUnknownTextures();
+      int depthMask = -1;
+
+      RenderState::FrameStats currentFrame, lastFrame;
+    } s_data;
+
+    void RenderState::UseProgram(GLuint program) {
+      if (s_data.program == program) {
+        ++s_data.currentFrame.skippedStateChanges;
+        return;
+      }
+
+      glUseProgram(program);
+      s_data.program = program;
+      ++s_data.currentFrame.stateChanges;
+    }
+
+    void RenderState::BindVertexArray(GLuint vertexArray) {
+      if (s_data.vertexArray == vertexArray) {
+        ++s_data.currentFrame.skippedStateChanges;
+        return;
+      }
+
+      glBindVertexArray(vertexArray);
+      s_data.vertexArray = vertexArray;
+      ++s_data.currentFrame.stateChanges;
+    }
+
+    void RenderState::BindTexture(GLuint unit, GLuint texture) {
+      if (s_data.textures[unit] == texture) {
+        ++s_data.currentFrame.skippedStateChanges;
+        return;
+      }
+
+      if (s_data.activeTextureUnit != unit) {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        s_data.activeTextureUnit = unit;
+        ++s_data.currentFrame.stateChanges;
+      }
+
+      glBindTexture(GL_TEXTURE_2D, texture);
+      s_data.textures[unit] = texture;
+      ++s_data.currentFrame.stateChanges;
+    }
+
+    void RenderState::SetDepthMask(bool isEnabled) {
+      if (s_data.depthMask == static_cast<int>(isEnabled)) {
+        ++s_data.currentFrame.skippedStateChanges;
+        return;
+      }
+
+      glDepthMask(isEnabled ? GL_TRUE : GL_FALSE);
+      s_data.depthMask = static_cast<int>(isEnabled);
+      ++s_data.currentFrame.stateChanges;
+    }
+
+    void RenderState::OnVertexArrayDeleted(GLuint vertexArray) {
+      if (s_data.vertexArray == vertexArray) {
+        s_data.vertexArray = 0;
+      }
+    }
+
+    void RenderState::OnTextureDeleted(GLuint texture) {
+      for (GLuint &boundTexture : s_data.textures) {
+        if (boundTexture == texture) {
+          boundTexture = 0;
+        }
+      }
+    }
+
+    void RenderState::Invalidate() {
+      s_data.program = UNKNOWN;
+      s_data.vertexArray = UNKNOWN;
+      s_data.activeTextureUnit = UNKNOWN;
+      s_data.textures.fill(UNKNOWN);
+      s_data.depthMask = -1;
+    }
+
+    void RenderState::CountUniformUpload() {
+      ++s_data.currentFrame.uniformUploads;
+    }
+
+    void RenderState::CountBufferUpload() {
+      ++s_data.currentFrame.bufferUploads;
+    }
+
+    void RenderState::CountDrawCall() {
+      ++s_data.currentFrame.drawCalls;
+    }
+
+    auto RenderState::GetFrameStats() -> const FrameStats & {
+      return s_data.lastFrame;
+    }
+
+    void RenderState::EndFrame() {
+      s_data.lastFrame = s_data.currentFrame;
+      s_data.currentFrame = FrameStats{};
+    }
+
+  }
+
+}
@@ -17,6 +17,8 @@ namespace TinyMinecraft {
       , m_blockAtlasTexture("../resources/textures/block_atlas.png")
       , m_viewportWidth(viewportWidth)
       , m_viewportHeight(viewportHeight)
+      , m_frameUniforms(GL_UNIFORM_BUFFER)
+      , m_farTerrain(m_blockAtlasTexture)
     {
       PROFILE_SCOPE(Graphics, "Renderer::Initialize")
 
@@ -27,11 +29,14 @@ namespace TinyMinecraft {
       glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
       glEnable( GL_BLEND );
 
-      m_blockShader.Use();
-      m_blockShader.Uniform("uBlockAtlas", 0);
+      m_blockShader.Uniform("uBlockAtlas", static_cast<int>(m_blockAtlasTexture.GetId()));
+      m_waterShader.Uniform("uBlockAtlas", static_cast<int>(m_blockAtlasTexture.GetId()));
 
-      m_waterShader.Use();
-      m_waterShader.Uniform("uBlockAtlas", 0);
+      // camera constants shared by every 3D shader, written once per frame in Begin3D
+      m_frameUniforms.Allocate(sizeof(FrameUniforms), GL_DYNAMIC_DRAW);
+      glBindBufferBase(GL_UNIFORM_BUFFER, FRAME_UNIFORMS_BINDING, m_frameUniforms.GetHandle());
+      m_blockShader.BindUniformBlock("FrameUniforms", FRAME_UNIFORMS_BINDING);
+      m_waterShader.BindUniformBlock("FrameUniforms", FRAME_UNIFORMS_BINDING);
 
       //// TODO: Remove
       // Shadows
@@ -42,62 +47,223 @@ namespace TinyMinecraft {
     }
 
     void Renderer::RenderWorld(World::World &world) {
-      m_blockShader.Use();
-      m_blockShader.Uniform("uBlockAtlas", static_cast<int>(m_blockAtlasTexture.GetId()));
-      m_blockShader.Uniform("uCameraPos", m_playerPosition);
-
-      glm::vec3 playerPos = m_playerPosition;
-      
-      std::vector<World::Chunk *> translucentChunks;
-      
-      for (auto &[chunkPos, chunk] : world.GetChunks()) {
-        if (world.IsChunkEmpty(chunkPos)) {
-          chunk->ClearBuffers();
+      UpdateRenderList(world);
+
+      if (HasCamera()) {
+        m_culler.Begin(m_renderList, m_chunkVisibility, m_chunkBounds, m_currentCamera->GetViewProjection(), m_currentCamera->GetPosition());
+      }
+
+      const glm::vec3 cameraPos = HasCamera() ? m_currentCamera->GetPosition() : m_playerPosition;
+      const glm::ivec2 cameraChunkPos = world.GetChunkPosFromCoords(cameraPos);
+
+      // upload even if culled so turning around does not stall on buffering; overlaps the occlusion pass
+      size_t uploadedBytes = UploadMeshes(cameraChunkPos);
+
+    #ifdef GFX_FarTerrain
+      // from what the chunks left of the budget
+      uploadedBytes += m_farTerrain.Update(world.GetFarTerrain(), m_uploadBudget > uploadedBytes ? m_uploadBudget - uploadedBytes : 0);
+    #endif
+
+      CullChunks();
+      m_stats.pendingMeshes = m_pendingMeshes.size() + m_farTerrain.GetPendingCount();
+      m_stats.uploadedBytes = uploadedBytes;
+
+      PROFILE_COUNTER("pending meshes", m_stats.pendingMeshes)
+      PROFILE_COUNTER("uploaded KB", uploadedBytes / 1024)
+
+      for (World::Chunk *chunk : m_visibleChunks) {
+        chunk->SetHidden(false);
+        chunk->MarkDrawn();
+      }
+
+      m_regions.Draw(m_visibleChunks, m_blockShader);
+
+    #ifdef GFX_FarTerrain
+      if (HasCamera()) {
+        // the chunks within a chunk of the render distance are all loaded
+        const glm::vec2 innerCenter = (glm::vec2(cameraChunkPos) + 0.5f) * static_cast<float>(CHUNK_WIDTH);
+        m_farTerrain.Draw(m_currentCamera->GetViewProjection(), innerCenter, (GFX_RENDER_DISTANCE - 1) * CHUNK_WIDTH);
+      }
+    #endif
+
+      SortTranslucentChunks(cameraChunkPos);
+      RenderState::SetDepthMask(false);
+
+      for (World::Chunk *chunk : m_translucentChunks) {
+        if (chunk->IsHidden()) {
           continue;
         }
 
-        if (chunk->HasTranslucentBlocks()) {
-          translucentChunks.push_back(chunk.get());
-        }
+        const glm::ivec2 chunkPos = chunk->GetChunkPos();
 
         glm::mat4 model { 1.0f };
         model = glm::translate(model, glm::vec3(chunkPos.x * CHUNK_WIDTH, 0.0f, chunkPos.y * CHUNK_LENGTH));
 
-        if (chunk->IsDirty()) {
-          chunk->BufferVertices();
+        RenderMesh(chunk->GetTranslucentMesh(), m_blockShader, model);
+      }
+
+      RenderState::SetDepthMask(true);
+
+      for (World::Chunk *chunk : m_visibleChunks) {
+        chunk->SetHidden(true);
+      }
+    }
 
-          chunk->SetDirty(false);
+    void Renderer::UpdateRenderList(World::World &world) {
+      PROFILE_FUNCTION(Graphics)
+
+      World::ChunkRenderEvent event;
+
+      while (world.PollRenderEvent(event)) {
+        World::Chunk *chunk = event.chunk;
+        const auto it = m_renderListIndex.find(chunk);
+
+        if (event.type == World::ChunkRenderEvent::Type::Unloaded) {
+          chunk->ClearBuffers();
+          m_regions.Remove(chunk);
+          m_pendingMeshes.erase(chunk);
+
+          if (it != m_renderListIndex.end()) {
+            const size_t index = it->second;
+
+            m_renderList[index] = m_renderList.back();
+            m_renderListIndex[m_renderList[index]] = index;
+            m_renderList.pop_back();
+            m_chunkBounds.RemoveSwap(index);
+            m_chunkVisibility[index] = m_chunkVisibility.back();
+            m_chunkVisibility.pop_back();
+            m_renderListIndex.erase(chunk);
+          }
+
+          RemoveTranslucentChunk(chunk);
+          continue;
         }
 
-        RenderMesh(chunk->GetMesh(), m_blockShader, model);
+        // the chunk itself may already be meshing again
+        const World::ChunkVisibility &visibility = event.mesh->visibility;
+
+        const glm::ivec2 chunkPos = chunk->GetChunkPos();
+        const glm::vec3 min(chunkPos.x * CHUNK_WIDTH, visibility.minHeight, chunkPos.y * CHUNK_LENGTH);
+        const glm::vec3 max(min.x + CHUNK_WIDTH, visibility.maxHeight + 1, min.z + CHUNK_LENGTH);
+
+        // meshed again after a block change, only the bounds may have moved
+        if (it != m_renderListIndex.end()) {
+          m_chunkBounds.Set(it->second, min, max);
+          m_chunkVisibility[it->second] = visibility;
+        } else {
+          m_renderListIndex[chunk] = m_renderList.size();
+          m_renderList.push_back(chunk);
+          m_chunkBounds.Add(min, max);
+          m_chunkVisibility.push_back(visibility);
+        }
+
+        if (!visibility.hasTranslucentBlocks) {
+          RemoveTranslucentChunk(chunk);
+        } else if (!m_translucentIndex.contains(chunk)) {
+          m_translucentIndex[chunk] = m_translucentChunks.size();
+          m_translucentChunks.push_back(chunk);
+          m_isTranslucentOrderDirty = true;
+        }
+
+        // replaces a mesh of the chunk that has not been uploaded yet
+        m_pendingMeshes[chunk] = std::move(event.mesh);
       }
+    }
 
-      glm::vec2 playerChunkPos = world.GetChunkPosFromCoords(playerPos);
+    auto Renderer::UploadMeshes(const glm::ivec2 &cameraChunkPos) -> size_t {
+      PROFILE_FUNCTION(Graphics)
 
-      std::ranges::sort(translucentChunks, [playerChunkPos](World::Chunk *a, World::Chunk *b) {
-        float distanceA = glm::distance(playerChunkPos, static_cast<glm::vec2>(a->GetChunkPos()));
-        float distanceB = glm::distance(playerChunkPos, static_cast<glm::vec2>(b->GetChunkPos()));
+      const auto distance = [&](const World::Chunk *chunk) {
+        const glm::ivec2 offset = chunk->GetChunkPos() - cameraChunkPos;
+        return offset.x * offset.x + offset.y * offset.y;
+      };
 
-        return distanceA > distanceB;
-      });
+      m_uploadOrder.clear();
+      for (const auto &[chunk, mesh] : m_pendingMeshes) {
+        m_uploadOrder.push_back(chunk);
+      }
 
-      for (auto chunk : translucentChunks) {
+      // nearest first, so block changes around the player and the chunks in front of it come in first
+      std::ranges::sort(m_uploadOrder, {}, distance);
 
-        //TODO: abstract to mesh
-        if (chunk->IsTranslucentDirty()) {
-          chunk->BufferTranslucentVertices();
-          chunk->SetTranslucentDirty(false);
+      size_t uploadedBytes = 0;
+
+      for (World::Chunk *chunk : m_uploadOrder) {
+        const auto it = m_pendingMeshes.find(chunk);
+        const size_t size = it->second->GetSizeInBytes();
+
+        // a mesh larger than the whole budget still goes through on its own
+        if (uploadedBytes > 0 && uploadedBytes + size > m_uploadBudget) {
+          break;
         }
 
-        const glm::ivec2 chunkPos = chunk->GetChunkPos();
+        m_regions.Upload(chunk, *it->second);
+        chunk->SetTranslucentGeometry(it->second->translucent);
+        m_pendingMeshes.erase(it);
+        uploadedBytes += size;
+      }
 
-        glm::mat4 model { 1.0f };
-        model = glm::translate(model, glm::vec3(chunkPos.x * CHUNK_WIDTH, 0.0f, chunkPos.y * CHUNK_LENGTH));
+      return uploadedBytes;
+    }
 
-        glDepthMask(GL_FALSE);
-        RenderMesh(chunk->GetTranslucentMesh(), m_blockShader, model);
-        glDepthMask(GL_TRUE);
+    void Renderer::RemoveTranslucentChunk(World::Chunk *chunk) {
+      const auto it = m_translucentIndex.find(chunk);
+      if (it == m_translucentIndex.end()) {
+        return;
+      }
+
+      // swapped out like in the render list, the next sort puts the moved chunk back in place
+      const size_t index = it->second;
+      m_translucentChunks[index] = m_translucentChunks.back();
+      m_translucentIndex[m_translucentChunks[index]] = index;
+      m_translucentChunks.pop_back();
+      m_translucentIndex.erase(chunk);
+      m_isTranslucentOrderDirty = true;
+    }
+
+    void Renderer::SortTranslucentChunks(const glm::ivec2 &cameraChunkPos) {
+      if (!m_isTranslucentOrderDirty && cameraChunkPos == m_translucentOrigin) {
+        return;
+      }
+
+      const auto distance = [&](const World::Chunk *chunk) {
+        const glm::ivec2 offset = chunk->GetChunkPos() - cameraChunkPos;
+        return offset.x * offset.x + offset.y * offset.y;
+      };
+
+      // farthest first; the order barely changes between calls, so insertion sort is close to linear
+      for (size_t i = 1; i < m_translucentChunks.size(); ++i) {
+        World::Chunk *chunk = m_translucentChunks[i];
+        const int chunkDistance = distance(chunk);
+
+        size_t j = i;
+        for (; j > 0 && distance(m_translucentChunks[j - 1]) < chunkDistance; --j) {
+          m_translucentChunks[j] = m_translucentChunks[j - 1];
+        }
+        m_translucentChunks[j] = chunk;
+      }
+
+      for (size_t i = 0; i < m_translucentChunks.size(); ++i) {
+        m_translucentIndex[m_translucentChunks[i]] = i;
       }
+
+      m_translucentOrigin = cameraChunkPos;
+      m_isTranslucentOrderDirty = false;
+    }
+
+    void Renderer::CullChunks() {
+      PROFILE_FUNCTION(Graphics)
+
+      if (!HasCamera()) {
+        m_visibleChunks = m_renderList;
+        m_stats = RenderStats{};
+        m_stats.drawnChunks = m_visibleChunks.size();
+        return;
+      }
+
+      m_culler.Finish();
+      m_visibleChunks = m_culler.GetVisibleChunks();
+      m_stats = m_culler.GetStats();
     }
 
     void Renderer::RenderMesh(Geometry::Mesh &mesh, Shader &shader, glm::mat4 &model) {
@@ -109,6 +275,7 @@ namespace TinyMinecraft {
 
       mesh.BindVertexArray();
       glDrawElements(GL_TRIANGLES, mesh.GetVertexCount(), GL_UNSIGNED_INT, nullptr);
+      RenderState::CountDrawCall();
     }
 
     void Renderer::RenderUI(UI::UserInterface &ui) {
@@ -130,11 +297,10 @@ namespace TinyMinecraft {
 
       glEnable(GL_FRAMEBUFFER_SRGB); 
 
-      m_blockShader.Use();
-      m_blockShader.Uniform("uViewProjection", m_currentCamera->GetViewProjection());
-
-      m_waterShader.Use();
-      m_waterShader.Uniform("uViewProjection", m_currentCamera->GetViewProjection());
+      const FrameUniforms frameUniforms { m_currentCamera->GetViewProjection(), glm::vec4(m_currentCamera->GetPosition(), 1.0f) };
+      m_frameUniforms.Bind();
+      glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameUniforms), &frameUniforms);
+      RenderState::CountBufferUpload();
     }
 
     void Renderer::End3D() {
@@ -1,6 +1,8 @@
 #include "Graphics/Renderer2D.h"
 #include "Graphics/BufferObject.h"
+#include "Graphics/RenderState.h"
 #include "Graphics/Shader.h"
+#include "Graphics/StreamBuffer.h"
 #include "Graphics/Texture.h"
 #include "Graphics/VertexArray.h"
 #include "Graphics/gfx.h"
@@ -8,6 +10,7 @@
 #include <array>
 #include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <memory>
 #include <ranges>
 
@@ -41,17 +44,17 @@ namespace TinyMinecraft {
       int textIndexCount = 0;
 
       std::unique_ptr<VertexArray> rectVAO;
-      std::unique_ptr<BufferObject> rectVBO;
+      std::unique_ptr<StreamBuffer> rectVBO;
       std::unique_ptr<Shader> rectShader;
       std::vector<RectVertex> rectVertices;
 
       std::unique_ptr<VertexArray> lineVAO;
-      std::unique_ptr<BufferObject> lineVBO;
+      std::unique_ptr<StreamBuffer> lineVBO;
       std::unique_ptr<Shader> lineShader;
       std::vector<LineVertex> lineVertices;
 
       std::unique_ptr<VertexArray> textVAO;
-      std::unique_ptr<BufferObject> textVBO;
+      std::unique_ptr<StreamBuffer> textVBO;
       std::unique_ptr<Shader> textShader;
       std::vector<TextVertex> textVertices;
 
@@ -66,10 +69,22 @@ namespace TinyMinecraft {
 
     static Renderer2DData s_data;
 
+    // Writes the first `count` vertices into the stream buffer and returns the index of the first one there.
+    // The buffer holds MAX_VERTICES, more than that are not drawn.
+    template <typename T>
+    static auto StreamVertices(StreamBuffer &buffer, const std::vector<T> &vertices, size_t count) -> GLint {
+      const auto size = static_cast<GLsizeiptr>(sizeof(T) * count);
+
+      std::memcpy(buffer.Map(size, sizeof(T)), vertices.data(), size);
+      buffer.Unmap();
+
+      return static_cast<GLint>(buffer.GetMappedOffset() / static_cast<GLintptr>(sizeof(T)));
+    }
+
     void Renderer2D::Initialize() {
       // rect
       s_data.rectVAO = std::make_unique<VertexArray>();
-      s_data.rectVBO = std::make_unique<BufferObject>(GL_ARRAY_BUFFER);
+      s_data.rectVBO = std::make_unique<StreamBuffer>(GL_ARRAY_BUFFER, Renderer2DData::MAX_VERTICES * sizeof(RectVertex));
       s_data.quadEBO = std::make_unique<BufferObject>(GL_ELEMENT_ARRAY_BUFFER);
 
       s_data.rectVAO->AddAttribute(0, 2, GL_FLOAT, sizeof(RectVertex), offsetof(RectVertex, position));
@@ -79,7 +94,7 @@ namespace TinyMinecraft {
 
       // line
       s_data.lineVAO = std::make_unique<VertexArray>();
-      s_data.lineVBO = std::make_unique<BufferObject>(GL_ARRAY_BUFFER);
+      s_data.lineVBO = std::make_unique<StreamBuffer>(GL_ARRAY_BUFFER, Renderer2DData::MAX_VERTICES * sizeof(LineVertex));
 
       s_data.lineVAO->AddAttribute(0, 2, GL_FLOAT, sizeof(LineVertex), offsetof(LineVertex, position));
       s_data.lineVAO->AddAttribute(1, 4, GL_FLOAT, sizeof(LineVertex), offsetof(LineVertex, color));
@@ -88,7 +103,7 @@ namespace TinyMinecraft {
 
       // text
       s_data.textVAO = std::make_unique<VertexArray>();
-      s_data.textVBO = std::make_unique<BufferObject>(GL_ARRAY_BUFFER);
+      s_data.textVBO = std::make_unique<StreamBuffer>(GL_ARRAY_BUFFER, Renderer2DData::MAX_VERTICES * sizeof(TextVertex));
 
       s_data.textVAO->AddAttribute(0, 2, GL_FLOAT, sizeof(TextVertex), offsetof(TextVertex, position));
       s_data.textVAO->AddAttribute(1, 4, GL_FLOAT, sizeof(TextVertex), offsetof(TextVertex, color));
@@ -138,24 +153,28 @@ namespace TinyMinecraft {
         s_data.rectVAO->Bind();
         s_data.rectShader->Use();
 
-        s_data.rectVBO->BufferData(s_data.rectVertices, GL_DYNAMIC_DRAW);
+        const int indexCount = std::min(s_data.rectIndexCount, Renderer2DData::MAX_INDICES);
+        const GLint baseVertex = StreamVertices(*s_data.rectVBO, s_data.rectVertices, indexCount / 6 * 4);
 
-        glDrawElements(GL_TRIANGLES, s_data.rectIndexCount, GL_UNSIGNED_INT, nullptr);
+        glDrawElementsBaseVertex(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, nullptr, baseVertex);
         s_data.rectVertices.clear();
 
         s_data.stats.drawCalls++;
+        RenderState::CountDrawCall();
       }
 
       if (s_data.lineVertexCount > 0) {
         s_data.lineVAO->Bind();
         s_data.lineShader->Use();
 
-        s_data.lineVBO->BufferData(s_data.lineVertices, GL_DYNAMIC_DRAW);
+        const int vertexCount = std::min(s_data.lineVertexCount, Renderer2DData::MAX_VERTICES);
+        const GLint firstVertex = StreamVertices(*s_data.lineVBO, s_data.lineVertices, vertexCount);
 
-        glDrawArrays(GL_LINES, 0, s_data.lineVertexCount);
+        glDrawArrays(GL_LINES, firstVertex, vertexCount);
         s_data.lineVertices.clear();
 
         s_data.stats.drawCalls++;
+        RenderState::CountDrawCall();
       }
 
       if (s_data.textIndexCount > 0) {
@@ -163,12 +182,14 @@ namespace TinyMinecraft {
         s_data.textVAO->Bind();
         s_data.textShader->Use();
 
-        s_data.textVBO->BufferData(s_data.textVertices, GL_DYNAMIC_DRAW);
+        const int indexCount = std::min(s_data.textIndexCount, Renderer2DData::MAX_INDICES);
+        const GLint baseVertex = StreamVertices(*s_data.textVBO, s_data.textVertices, indexCount / 6 * 4);
 
-        glDrawElements(GL_TRIANGLES, s_data.textIndexCount, GL_UNSIGNED_INT, nullptr);
+        glDrawElementsBaseVertex(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, nullptr, baseVertex);
         s_data.textVertices.clear();
 
         s_data.stats.drawCalls++;
+        RenderState::CountDrawCall();
       }
 
       s_data.stats.quadCount = 0;
@@ -22,6 +22,7 @@ namespace TinyMinecraft {
       m_fragmentHandle = Compile(rawFragmentFile.c_str(), GL_FRAGMENT_SHADER, fragmentPath);
 
       m_programHandle = Link();
+      ReflectUniforms();
     }
 
     Shader::~Shader() {
@@ -77,9 +78,9 @@ namespace TinyMinecraft {
 
       std::array<char, LOG_READ_SIZE> infoLog {};
       int success = false;
-      glGetProgramiv(m_programHandle, GL_LINK_STATUS, &success);
+      glGetProgramiv(program, GL_LINK_STATUS, &success);
       if (!success) {
-        glGetShaderInfoLog(m_programHandle, LOG_READ_SIZE, nullptr, infoLog.data());
+        glGetProgramInfoLog(program, LOG_READ_SIZE, nullptr, infoLog.data());
         // Utils::Logger::Error("Shader: Failed to link shaders. Error Message:\n{}", infoLog, infoLog.data());
       }
 
@@ -89,6 +90,47 @@ namespace TinyMinecraft {
       return program;
     }
 
+    void Shader::ReflectUniforms() {
+      int uniformCount = 0, maxNameLength = 0;
+      glGetProgramiv(m_programHandle, GL_ACTIVE_UNIFORMS, &uniformCount);
+      glGetProgramiv(m_programHandle, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+      std::string name(static_cast<size_t>(maxNameLength), '\0');
+
+      for (int i = 0; i < uniformCount; ++i) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(m_programHandle, static_cast<GLuint>(i), maxNameLength, &length, &size, &type, name.data());
+
+        // members of uniform blocks have no location
+        const std::string uniformName = name.substr(0, static_cast<size_t>(length));
+        const GLint location = glGetUniformLocation(m_programHandle, uniformName.c_str());
+        if (location < 0) {
+          continue;
+        }
+
+        m_uniformLocations[uniformName] = location;
+
+        // arrays are reported as "name[0]", but may be set through "name" as well
+        if (uniformName.ends_with("[0]")) {
+          m_uniformLocations[uniformName.substr(0, uniformName.size() - 3)] = location;
+        }
+      }
+    }
+
+    auto Shader::GetUniformLocation(const std::string &name) const -> GLint {
+      const auto it = m_uniformLocations.find(name);
+      return it != m_uniformLocations.end() ? it->second : -1;
+    }
+
+    void Shader::BindUniformBlock(const std::string &name, GLuint binding) {
+      const GLuint index = glGetUniformBlockIndex(m_programHandle, name.c_str());
+      if (index != GL_INVALID_INDEX) {
+        glUniformBlockBinding(m_programHandle, index, binding);
+      }
+    }
+
   }
 
 }
@@ -0,0 +1,140 @@
+#include "Graphics/StreamBuffer.h"
+
+#include "Graphics/RenderState.h"
+#include "Utils/Logger.h"
+#include "Utils/Profiler.h"
+
+namespace TinyMinecraft {
+
+  namespace Graphics {
+
+    StreamBuffer::StreamBuffer(GLenum target, GLsizeiptr capacity)
+      : m_buffer(target)
+      , m_target(target)
+      , m_capacity(capacity)
+    {
+    #ifdef GL_ARB_buffer_storage
+      if (GLAD_GL_ARB_buffer_storage) {
+        constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+        m_buffer.AllocateStorage(m_capacity, flags);
+        m_persistentData = static_cast<uint8_t *>(glMapBufferRange(m_target, 0, m_capacity, flags));
+
+        if (m_persistentData) {
+          return;
+        }
+
+        // the storage is immutable, start over with a new buffer
+        Utils::Logger::Warning("Could not map stream buffer persistently, falling back to orphaning.");
+        m_buffer = BufferObject(target);
+      }
+    #endif
+
+      m_buffer.Allocate(m_capacity, GL_STREAM_DRAW);
+    }
+
+    StreamBuffer::~StreamBuffer() {
+      for (const Fence &fence : m_fences) {
+        glDeleteSync(fence.sync);
+      }
+
+      if (IsPersistent()) {
+        Bind();
+        glUnmapBuffer(m_target);
+      }
+    }
+
+    auto StreamBuffer::Map(GLsizeiptr size, GLsizeiptr alignment) -> void * {
+      if (size > m_capacity) {
+        Utils::Logger::Error("Cannot map {} bytes of a {} bytes stream buffer", size, m_capacity);
+        exit(1);
+      }
+
+      const uint64_t lapStart = m_position - m_position % m_capacity;
+      GLintptr offset = (static_cast<GLintptr>(m_position % m_capacity) + alignment - 1) / alignment * alignment;
+
+      // ranges never straddle the end of the ring
+      const bool wraps = offset + size > m_capacity;
+      if (wraps) {
+        offset = 0;
+      }
+
+      const uint64_t start = (wraps ? lapStart + m_capacity : lapStart) + offset;
+      const uint64_t end = start + size;
+
+      Bind();
+      m_mappedOffset = offset;
+      RenderState::CountBufferUpload();
+
+      if (IsPersistent()) {
+        // everything written so far has been used by the commands issued since, see Map
+        if (m_position > m_fencedPosition) {
+          m_fences.push_back(Fence{ glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), m_position });
+          m_fencedPosition = m_position;
+        }
+
+        // the range still holds what was written one lap earlier
+        if (end > static_cast<uint64_t>(m_capacity)) {
+          WaitForRange(end - m_capacity);
+        }
+
+        m_position = end;
+        return m_persistentData + offset;
+      }
+
+      // a new lap gets new storage; the driver keeps the old one alive for the draws still reading it
+      if (wraps) {
+        m_buffer.Allocate(m_capacity, GL_STREAM_DRAW);
+      }
+
+      void *data = glMapBufferRange(m_target, offset, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+      if (!data) {
+        Utils::Logger::Error("Could not map {} bytes of a stream buffer", size);
+        exit(1);
+      }
+
+      m_position = end;
+      return data;
+    }
+
+    void StreamBuffer::Unmap() {
+      if (!IsPersistent()) {
+        Bind();
+        glUnmapBuffer(m_target);
+      }
+    }
+
+    void StreamBuffer::WaitForRange(uint64_t end) {
+      PROFILE_FUNCTION(Graphics)
+
+      constexpr GLuint64 timeout = 1'000'000'000; // ns
+
+      // fences are in ring order, so the first one past `end` also covers the ones before it
+      while (!m_fences.empty()) {
+        const Fence fence = m_fences.front();
+        const bool coversRange = fence.position >= end || m_fences.size() == 1;
+
+        if (coversRange) {
+          GLenum result = glClientWaitSync(fence.sync, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+          while (result == GL_TIMEOUT_EXPIRED) {
+            result = glClientWaitSync(fence.sync, 0, timeout);
+          }
+
+          if (result == GL_WAIT_FAILED) {
+            Utils::Logger::Error("Waiting for a stream buffer fence failed");
+            exit(1);
+          }
+        }
+
+        glDeleteSync(fence.sync);
+        m_fences.pop_front();
+
+        if (coversRange) {
+          break;
+        }
+      }
+    }
+
+  }
+
+}
@@ -1,4 +1,5 @@
 #include "Graphics/Texture.h"
+#include "Graphics/RenderState.h"
 #include "Graphics/gfx.h"
 #include "Utils/Logger.h"
 #include <iostream>
@@ -12,7 +13,6 @@
 #include <stb_image.h>
 #pragma clang diagnostic pop
 
-#define SET_ACTIVE(i) glActiveTexture(GL_TEXTURE##i);
 #define MAX_MIP_MAPS 5
 
 namespace TinyMinecraft {
@@ -24,6 +24,11 @@ namespace TinyMinecraft {
     Texture::Texture(const std::string &filePath)
       : m_id(Texture::currentTextureId++)
     {
+      if (m_id >= RenderState::MAX_TEXTURE_UNITS) {
+        Utils::Logger::Error("Texture {}: Out of texture units!", m_id);
+        exit(1);
+      }
+
       glGenTextures(1, &m_handle);
 
       unsigned char *data = stbi_load(filePath.c_str(), &m_width, &m_height, &m_channelCount, 0);
@@ -64,22 +69,13 @@ namespace TinyMinecraft {
     }
 
     Texture::~Texture() {
-      glDeleteTextures(1, &m_id);
+      glDeleteTextures(1, &m_handle);
+      RenderState::OnTextureDeleted(m_handle);
     }
 
     void Texture::Bind() const {
-      if (m_id == 0) SET_ACTIVE(0)
-      if (m_id == 1) SET_ACTIVE(1)
-      if (m_id == 2) SET_ACTIVE(2)
-      if (m_id == 3) SET_ACTIVE(3)
-      if (m_id == 4) SET_ACTIVE(4)
-      if (m_id == 5) SET_ACTIVE(5)
-      if (m_id == 6) SET_ACTIVE(6)
-      if (m_id == 7) SET_ACTIVE(7)
-      if (m_id == 8) SET_ACTIVE(8)
-      if (m_id == 9) SET_ACTIVE(9)
-
-      glBindTexture(GL_TEXTURE_2D, m_handle);
+      // every texture has a unit of its own
+      RenderState::BindTexture(m_id, m_handle);
     }
 
   }
@@ -13,6 +13,7 @@ namespace TinyMinecraft {
 
     VertexArray::~VertexArray() {
       glDeleteVertexArrays(1, &m_handle);
+      RenderState::OnVertexArrayDeleted(m_handle);
     }
 
     VertexArray::VertexArray(VertexArray &&other) noexcept
@@ -1,12 +1,16 @@
 #include "Graphics/WireframeRenderer.h"
 #include "Graphics/BufferObject.h"
+#include "Graphics/RenderState.h"
 #include "Graphics/Shader.h"
+#include "Graphics/StreamBuffer.h"
 #include "Graphics/VertexArray.h"
 #include "Graphics/gfx.h"
 #include "Scene/PlayerCameras.h"
 #include "Utils/Logger.h"
 #include "Utils/defs.h"
 #include "glm/fwd.hpp"
+#include <algorithm>
+#include <cstring>
 #include <memory>
 
 namespace TinyMinecraft {
@@ -19,8 +23,13 @@ namespace TinyMinecraft {
     };
 
     static struct WireframeRendererData {
+      // every shape is a box of 8 vertices and 24 indices; boxes past the limit are not drawn
+      static constexpr size_t VERTICES_PER_BOX = 8;
+      static constexpr size_t INDICES_PER_BOX = 24;
+      static constexpr size_t MAX_BOXES = 4096;
+
       std::unique_ptr<VertexArray> vao;
-      std::unique_ptr<BufferObject> vbo, ebo;
+      std::unique_ptr<StreamBuffer> vbo, ebo;
       std::unique_ptr<Shader> shader;
 
       std::vector<WireframeVertex> vertices;
@@ -35,8 +44,8 @@ namespace TinyMinecraft {
       glEnable(GL_LINE_SMOOTH);
 
       s_data.vao = std::make_unique<VertexArray>();
-      s_data.vbo = std::make_unique<BufferObject>(GL_ARRAY_BUFFER);
-      s_data.ebo = std::make_unique<BufferObject>(GL_ELEMENT_ARRAY_BUFFER);
+      s_data.vbo = std::make_unique<StreamBuffer>(GL_ARRAY_BUFFER, WireframeRendererData::MAX_BOXES * WireframeRendererData::VERTICES_PER_BOX * sizeof(WireframeVertex));
+      s_data.ebo = std::make_unique<StreamBuffer>(GL_ELEMENT_ARRAY_BUFFER, WireframeRendererData::MAX_BOXES * WireframeRendererData::INDICES_PER_BOX * sizeof(GLuint));
 
       s_data.vao->AddAttribute(0, 3, GL_FLOAT, sizeof(WireframeVertex), offsetof(WireframeVertex, position));
       s_data.vao->AddAttribute(1, 4, GL_FLOAT, sizeof(WireframeVertex), offsetof(WireframeVertex, color));
@@ -56,10 +65,25 @@ namespace TinyMinecraft {
         s_data.vao->Bind();
         s_data.shader->Use();
 
-        s_data.vbo->BufferData(s_data.vertices, GL_DYNAMIC_DRAW);
-        s_data.ebo->BufferData(s_data.indices, GL_DYNAMIC_DRAW);
-
-        glDrawElements(GL_LINES, s_data.indexCount, GL_UNSIGNED_INT, nullptr);
+        const size_t boxCount = std::min(s_data.vertices.size() / WireframeRendererData::VERTICES_PER_BOX, WireframeRendererData::MAX_BOXES);
+        const auto vertexSize = static_cast<GLsizeiptr>(sizeof(WireframeVertex) * boxCount * WireframeRendererData::VERTICES_PER_BOX);
+        const auto indexSize = static_cast<GLsizeiptr>(sizeof(GLuint) * boxCount * WireframeRendererData::INDICES_PER_BOX);
+
+        std::memcpy(s_data.vbo->Map(vertexSize, sizeof(WireframeVertex)), s_data.vertices.data(), vertexSize);
+        s_data.vbo->Unmap();
+
+        // the vao is bound, so this also makes the stream the element buffer
+        std::memcpy(s_data.ebo->Map(indexSize, sizeof(GLuint)), s_data.indices.data(), indexSize);
+        s_data.ebo->Unmap();
+
+        glDrawElementsBaseVertex(
+          GL_LINES,
+          static_cast<GLsizei>(boxCount * WireframeRendererData::INDICES_PER_BOX),
+          GL_UNSIGNED_INT,
+          reinterpret_cast<const void *>(s_data.ebo->GetMappedOffset()),
+          static_cast<GLint>(s_data.vbo->GetMappedOffset() / static_cast<GLintptr>(sizeof(WireframeVertex)))
+        );
+        RenderState::CountDrawCall();
         s_data.vertices.clear();
         s_data.indices.clear();
       }
@@ -32,7 +32,73 @@ namespace TinyMinecraft {
 
       debug << "Chunk: "
             << m_chunkPosition.x << ", "
-            << m_chunkPosition.y << "\n\n";
+            << m_chunkPosition.y << "\n";
+
+      debug << "Chunks drawn: "
+            << m_drawnChunks << ", culled: "
+            << m_culledChunks << ", occluded: "
+            << m_occludedChunks << ", hidden: "
+            << m_hiddenChunks << "\n";
+
+      debug << std::fixed << std::setprecision(1);
+      debug << "Sections culled: "
+            << m_culledSectionFraction * 100.0f << "%\n";
+
+      debug << "Mesh uploads: "
+            << m_uploadedBytes / 1024.0f << " KiB, pending: "
+            << m_pendingMeshes << "\n";
+      debug << std::defaultfloat;
+
+      debug << "GL calls: "
+            << m_glCalls << ", draws: "
+            << m_drawCalls << ", skipped state changes: "
+            << m_skippedStateChanges << "\n";
+
+#ifdef UTILS_ChunkLifecycle
+      const auto ms = [](long long nanoseconds) { return static_cast<float>(nanoseconds) / 1e6f; };
+      const auto &stages = m_chunkLifecycle.stages;
+
+      debug << std::fixed << std::setprecision(1);
+      debug << "Chunk request to draw p50/p99: "
+            << ms(m_chunkLifecycle.requestToDrawP50) << "/"
+            << ms(m_chunkLifecycle.requestToDrawP99) << " ms, undrawn unloads: "
+            << m_chunkLifecycle.undrawnUnloadCount << " ("
+            << ms(m_chunkLifecycle.undrawnWork) << " ms)\n";
+
+      debug << "Chunk wait/run p50 (ms):";
+      for (size_t i = 0; i < World::CHUNK_STAGE_COUNT; ++i) {
+        debug << " " << World::ChunkLifecycle::GetStageName(static_cast<World::ChunkStage>(i)) << " "
+              << ms(stages[i].waitP50) << "/" << ms(stages[i].runP50);
+      }
+      debug << "\n";
+      debug << std::defaultfloat;
+#endif
+
+      const auto mb = [](long long bytes) { return static_cast<float>(bytes) / (1024.0f * 1024.0f); };
+
+      debug << std::fixed << std::setprecision(1);
+      debug << "Memory (MB): resident " << mb(m_memory.residentBytes) << "\n";
+      for (size_t i = 0; i < Utils::MEMORY_CATEGORY_COUNT; ++i) {
+        const Utils::MemoryCategoryStats &category = m_memory.categories[i];
+
+        debug << "  " << Utils::MemoryTracker::GetCategoryName(static_cast<Utils::MemoryCategory>(i)) << ": "
+              << mb(category.current) << ", peak " << mb(category.peak);
+        if (category.budget > 0 && category.current > category.budget) {
+          debug << ", over " << mb(category.budget);
+        }
+        debug << "\n";
+      }
+      debug << std::defaultfloat;
+
+#ifdef UTILS_CountAllocations
+      debug << std::fixed << std::setprecision(1);
+      debug << "Frame allocations: "
+            << m_frameAllocations << " ("
+            << static_cast<float>(m_frameAllocatedBytes) / 1024.0f << " KiB)\n";
+      debug << std::defaultfloat;
+#endif
+
+      debug << "\n";
 
       debug << std::fixed << std::setprecision(5);
       debug << "Environment: "
@@ -87,6 +153,38 @@ namespace TinyMinecraft {
       m_chunkPosition = pos;
     }
 
+    void UserInterface::SetChunkCounts(size_t drawn, size_t culled, size_t occluded, size_t hidden, float culledSectionFraction) {
+      m_drawnChunks = drawn;
+      m_culledChunks = culled;
+      m_occludedChunks = occluded;
+      m_hiddenChunks = hidden;
+      m_culledSectionFraction = culledSectionFraction;
+    }
+
+    void UserInterface::SetGLCalls(int calls, int drawCalls, int skippedStateChanges) {
+      m_glCalls = calls;
+      m_drawCalls = drawCalls;
+      m_skippedStateChanges = skippedStateChanges;
+    }
+
+    void UserInterface::SetChunkLifecycle(const World::ChunkLifecycleStats &stats) {
+      m_chunkLifecycle = stats;
+    }
+
+    void UserInterface::SetFrameAllocations(uint64_t count, uint64_t bytes) {
+      m_frameAllocations = count;
+      m_frameAllocatedBytes = bytes;
+    }
+
+    void UserInterface::SetMemoryStats(const Utils::MemoryStats &stats) {
+      m_memory = stats;
+    }
+
+    void UserInterface::SetMeshUploads(size_t pending, size_t uploadedBytes) {
+      m_pendingMeshes = pending;
+      m_uploadedBytes = uploadedBytes;
+    }
+
   }
 
 }
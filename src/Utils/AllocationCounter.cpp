@@ -0,0 +1,185 @@
+#include "Utils/AllocationCounter.h"
+
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+  #include <malloc.h>
+#endif
+
+namespace TinyMinecraft {
+
+  namespace Utils {
+
+    namespace {
+
+      // constant initialized, so operator new reads it without running a constructor, even on a thread that exits
+      thread_local AllocationCount threadAllocations {};
+
+    }
+
+    auto AllocationCounter::GetThreadCount() -> AllocationCount {
+      return threadAllocations;
+    }
+
+  }
+
+}
+
+#ifdef UTILS_CountAllocations
+
+// Replaces the global allocation functions, counting each call to them on the calling thread. Allocation
+// otherwise works as the default ones do: malloc, the new handler on failure, and bad_alloc when there is none.
+namespace {
+
+  auto Allocate(std::size_t size) -> void * {
+    TinyMinecraft::Utils::AllocationCount &allocations = TinyMinecraft::Utils::threadAllocations;
+    ++allocations.count;
+    allocations.bytes += size;
+
+    while (true) {
+      if (void *pointer = std::malloc(size == 0 ? 1 : size)) {
+        return pointer;
+      }
+
+      const std::new_handler handler = std::get_new_handler();
+      if (!handler) {
+        throw std::bad_alloc();
+      }
+      handler();
+    }
+  }
+
+  auto AllocateAligned(std::size_t size, std::align_val_t alignment) -> void * {
+    TinyMinecraft::Utils::AllocationCount &allocations = TinyMinecraft::Utils::threadAllocations;
+    ++allocations.count;
+    allocations.bytes += size;
+
+    const auto align = static_cast<std::size_t>(alignment);
+    // aligned_alloc takes whole multiples of the alignment only
+    const std::size_t rounded = size == 0 ? align : (size + align - 1) / align * align;
+
+    while (true) {
+#ifdef _WIN32
+      if (void *pointer = _aligned_malloc(rounded, align)) {
+#else
+      if (void *pointer = std::aligned_alloc(align, rounded)) {
+#endif
+        return pointer;
+      }
+
+      const std::new_handler handler = std::get_new_handler();
+      if (!handler) {
+        throw std::bad_alloc();
+      }
+      handler();
+    }
+  }
+
+  void FreeAligned(void *pointer) {
+#ifdef _WIN32
+    _aligned_free(pointer);
+#else
+    std::free(pointer);
+#endif
+  }
+
+}
+
+auto operator new(std::size_t size) -> void * {
+  return Allocate(size);
+}
+
+auto operator new[](std::size_t size) -> void * {
+  return Allocate(size);
+}
+
+auto operator new(std::size_t size, const std::nothrow_t &) noexcept -> void * {
+  try {
+    return Allocate(size);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+auto operator new[](std::size_t size, const std::nothrow_t &) noexcept -> void * {
+  try {
+    return Allocate(size);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+auto operator new(std::size_t size, std::align_val_t alignment) -> void * {
+  return AllocateAligned(size, alignment);
+}
+
+auto operator new[](std::size_t size, std::align_val_t alignment) -> void * {
+  return AllocateAligned(size, alignment);
+}
+
+auto operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept -> void * {
+  try {
+    return AllocateAligned(size, alignment);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+auto operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept -> void * {
+  try {
+    return AllocateAligned(size, alignment);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void operator delete(void *pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void *pointer, const std::nothrow_t &) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void *pointer, const std::nothrow_t &) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void *pointer, std::align_val_t) noexcept {
+  FreeAligned(pointer);
+}
+
+void operator delete[](void *pointer, std::align_val_t) noexcept {
+  FreeAligned(pointer);
+}
+
+void operator delete(void *pointer, std::size_t, std::align_val_t) noexcept {
+  FreeAligned(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t, std::align_val_t) noexcept {
+  FreeAligned(pointer);
+}
+
+void operator delete(void *pointer, std::align_val_t, const std::nothrow_t &) noexcept {
+  FreeAligned(pointer);
+}
+
+void operator delete[](void *pointer, std::align_val_t, const std::nothrow_t &) noexcept {
+  FreeAligned(pointer);
+}
+
+#endif // UTILS_CountAllocations
@@ -0,0 +1,40 @@
+#include "Utils/LatencyHistogram.h"
+
+#include <cmath>
+
+namespace TinyMinecraft {
+
+  namespace Utils {
+
+    auto LatencyHistogram::GetPercentile(double percentile) const -> uint64_t {
+      if (m_count == 0) {
+        return 0;
+      }
+
+      const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(m_count))));
+
+      uint64_t seen = 0;
+      for (size_t index = 0; index < BUCKET_COUNT; ++index) {
+        seen += m_buckets[index];
+
+        if (seen >= rank) {
+          return std::min(GetBucketUpperBound(index), m_max);
+        }
+      }
+
+      return m_max;
+    }
+
+    auto LatencyHistogram::GetBucketUpperBound(size_t index) -> uint64_t {
+      if (index < LINEAR_COUNT) {
+        return index;
+      }
+
+      const size_t shift = (index - LINEAR_COUNT) / SUB_BUCKET_COUNT + 1;
+      const uint64_t subBucket = (index - LINEAR_COUNT) % SUB_BUCKET_COUNT + SUB_BUCKET_COUNT;
+      return ((subBucket + 1) << shift) - 1;
+    }
+
+  }
+
+}
@@ -1,22 +1,282 @@
 #include "Utils/Logger.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace TinyMinecraft {
 
   namespace Utils {
 
+    namespace {
+
+      struct LogRecord {
+        static constexpr size_t TEXT_CAPACITY = 232;
+
+        uint64_t sequence;
+        std::string *overflow;    // lines longer than the text, rare enough to allocate
+        uint32_t length;
+        std::array<char, TEXT_CAPACITY> text;
+      };
+
+      // single producer, the thread it belongs to, and single consumer, the writer
+      struct ThreadQueue {
+        static constexpr size_t CAPACITY = 256;
+
+        std::array<LogRecord, CAPACITY> records;
+        alignas(64) std::atomic<size_t> head = 0;
+        alignas(64) std::atomic<size_t> tail = 0;
+        std::atomic<bool> isRetired = false;
+      };
+
+      struct ThreadQueueHandle {
+        ThreadQueue *queue = nullptr;
+
+        ~ThreadQueueHandle() {
+          if (queue) {
+            queue->isRetired.store(true, std::memory_order_release);
+          }
+        }
+      };
+
+      // at the latest, the writer picks up what was logged after this long
+      constexpr auto WRITE_INTERVAL = std::chrono::milliseconds(10);
+
+      thread_local ThreadQueueHandle threadQueue;
+
+      // set once the writer is gone for good, trivially destructible so it outlives s_data
+      std::atomic<bool> isShutDown = false;
+
+      struct PendingRecord {
+        uint64_t sequence;
+        const LogRecord *record;
+      };
+
+      class LineBuffer : public std::streambuf {
+      public:
+        std::string *line = nullptr;
+
+      protected:
+        auto overflow(int_type c) -> int_type override {
+          if (c != traits_type::eof()) {
+            line->push_back(static_cast<char>(c));
+          }
+          return c;
+        }
+
+        auto xsputn(const char *data, std::streamsize count) -> std::streamsize override {
+          line->append(data, static_cast<size_t>(count));
+          return count;
+        }
+      };
+
+    }
+
+    static struct LoggerData {
+      std::mutex queueMutex;
+      std::vector<std::unique_ptr<ThreadQueue>> queues;
+
+      // orders the lines of different threads
+      std::atomic<uint64_t> nextSequence = 0;
+
+      // members rather than statics of the functions, which would be destroyed before the last lines are written
+      LoggerFn outputCallback = [](const std::string &msg) {
+        std::cout << msg;
+      };
+
+      // only used by the writer, kept to not allocate on every pass
+      std::vector<PendingRecord> pending;
+      std::vector<std::pair<ThreadQueue *, size_t>> heads;
+      std::string line;
+
+      std::once_flag writerStarted;
+      std::thread writer;
+      std::mutex writerMutex;
+      std::condition_variable writerCondition, flushCondition;
+      bool shouldTerminate = false;
+      bool isQueueFull = false;
+      // a flush is served by the first pass of the writer that starts after it was requested
+      uint64_t flushRequests = 0, servedFlushRequests = 0;
+
+      ~LoggerData() {
+        {
+          std::lock_guard<std::mutex> lock(writerMutex);
+          shouldTerminate = true;
+        }
+        writerCondition.notify_all();
+
+        if (writer.joinable()) {
+          writer.join();
+        }
+
+        isShutDown.store(true);
+      }
+    } s_data;
+
+    void Logger::RunWriterThread() {
+      SetThreadName("logger");
+
+      std::unique_lock<std::mutex> lock(s_data.writerMutex);
+      while (true) {
+        s_data.writerCondition.wait_for(lock, WRITE_INTERVAL, [] {
+          return s_data.flushRequests > s_data.servedFlushRequests || s_data.isQueueFull || s_data.shouldTerminate;
+        });
+        s_data.isQueueFull = false;
+        const uint64_t flushRequests = s_data.flushRequests;
+        const bool shouldTerminate = s_data.shouldTerminate;
+
+        lock.unlock();
+        // whatever was logged before the termination was asked for is written, even from threads that exited
+        while (WriteQueued()) {}
+        lock.lock();
+
+        s_data.servedFlushRequests = flushRequests;
+        s_data.flushCondition.notify_all();
+
+        if (shouldTerminate) {
+          return;
+        }
+      }
+    }
+
+    auto Logger::WriteQueued() -> bool {
+      std::vector<PendingRecord> &pending = s_data.pending;
+      std::vector<std::pair<ThreadQueue *, size_t>> &heads = s_data.heads;
+      std::string &line = s_data.line;
+      pending.clear();
+      heads.clear();
+
+      std::lock_guard<std::mutex> lock(s_data.queueMutex);
+
+      for (const std::unique_ptr<ThreadQueue> &queue : s_data.queues) {
+        const size_t head = queue->head.load(std::memory_order_acquire);
+        for (size_t tail = queue->tail.load(std::memory_order_relaxed); tail != head; ++tail) {
+          const LogRecord &record = queue->records[tail % ThreadQueue::CAPACITY];
+          pending.push_back(PendingRecord{ record.sequence, &record });
+        }
+        heads.emplace_back(queue.get(), head);
+      }
+
+      std::ranges::sort(pending, {}, &PendingRecord::sequence);
+
+      LoggerFn &output = GetOutputCallback();
+      for (const auto &[sequence, record] : pending) {
+        if (record->overflow) {
+          output(*record->overflow);
+          delete record->overflow;
+        } else {
+          line.assign(record->text.data(), record->length);
+          output(line);
+        }
+      }
+
+      for (const auto &[queue, head] : heads) {
+        queue->tail.store(head, std::memory_order_release);
+      }
+
+      // retired after the reads above means nothing more is coming
+      std::erase_if(s_data.queues, [](const std::unique_ptr<ThreadQueue> &queue) {
+        return queue->isRetired.load(std::memory_order_acquire) && queue->head.load(std::memory_order_acquire) == queue->tail.load(std::memory_order_relaxed);
+      });
+
+      return !pending.empty();
+    }
+
     void Logger::SetOutputCallback(LoggerFn func) {
+      std::lock_guard<std::mutex> lock(s_data.queueMutex);
       GetOutputCallback() = std::move(func);
     }
 
     auto Logger::GetOutputCallback() -> LoggerFn & {
-      static std::function<void(const std::string &)> outputCallback = [](const std::string &msg) {
-        std::cout << msg;
-      };
-      return outputCallback;
+      return s_data.outputCallback;
+    }
+
+    auto Logger::GetLineBuffer() -> std::string & {
+      static thread_local std::string line;
+      return line;
+    }
+
+    auto Logger::GetLineStream(std::string &line) -> std::ostream & {
+      static thread_local LineBuffer buffer;
+      static thread_local std::ostream stream(&buffer);
+
+      buffer.line = &line;
+      stream.flags(std::ios_base::dec | std::ios_base::skipws);
+      stream.precision(6);
+      stream.width(0);
+      stream.fill(' ');
+      return stream;
+    }
+
+    void Logger::Enqueue(std::string_view line) {
+      // nothing is left to write it, and the callback may be gone too
+      if (isShutDown.load(std::memory_order_relaxed)) {
+        std::fwrite(line.data(), 1, line.size(), stdout);
+        return;
+      }
+
+      std::call_once(s_data.writerStarted, [] { s_data.writer = std::thread(&Logger::RunWriterThread); });
+
+      ThreadQueue *queue = threadQueue.queue;
+      if (!queue) {
+        auto owned = std::make_unique<ThreadQueue>();
+        queue = owned.get();
+
+        std::lock_guard<std::mutex> lock(s_data.queueMutex);
+        s_data.queues.push_back(std::move(owned));
+        threadQueue.queue = queue;
+      }
+
+      const size_t head = queue->head.load(std::memory_order_relaxed);
+
+      // only with hundreds of lines in flight; waits for the writer instead of dropping any
+      if (head - queue->tail.load(std::memory_order_acquire) == ThreadQueue::CAPACITY) {
+        {
+          std::lock_guard<std::mutex> lock(s_data.writerMutex);
+          s_data.isQueueFull = true;
+        }
+        s_data.writerCondition.notify_one();
+
+        while (head - queue->tail.load(std::memory_order_acquire) == ThreadQueue::CAPACITY) {
+          std::this_thread::yield();
+        }
+      }
+
+      LogRecord &record = queue->records[head % ThreadQueue::CAPACITY];
+      record.sequence = s_data.nextSequence.fetch_add(1, std::memory_order_relaxed);
+
+      if (line.size() <= LogRecord::TEXT_CAPACITY) {
+        std::memcpy(record.text.data(), line.data(), line.size());
+        record.length = static_cast<uint32_t>(line.size());
+        record.overflow = nullptr;
+      } else {
+        record.length = 0;
+        record.overflow = new std::string(line);
+      }
+
+      queue->head.store(head + 1, std::memory_order_release);
+    }
+
+    void Logger::Flush() {
+      if (isShutDown.load(std::memory_order_relaxed)) {
+        return;
+      }
+
+      std::unique_lock<std::mutex> lock(s_data.writerMutex);
+      const uint64_t request = ++s_data.flushRequests;
+      s_data.writerCondition.notify_one();
+
+      s_data.flushCondition.wait(lock, [&] { return s_data.servedFlushRequests >= request || s_data.shouldTerminate; });
     }
 
-    auto Logger::GetColor(Level level) -> std::string {
+    auto Logger::GetColor(Level level) -> const char * {
       switch (level) {
         case Level::Message: return RESET;
         case Level::Debug: return BLUE;
@@ -28,7 +288,7 @@ namespace TinyMinecraft {
       }
     }
 
-    auto Logger::LevelToString(Level level) -> std::string {
+    auto Logger::LevelToString(Level level) -> const char * {
       switch (level) {
         case Level::Message: return "MESSAGE";
         case Level::Debug: return "DEBUG";
@@ -0,0 +1,152 @@
+#include "Utils/MemoryTracker.h"
+
+#include "Utils/Logger.h"
+#include "Utils/defs.h"
+#include <atomic>
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+
+#ifdef __APPLE__
+  #include <mach/mach.h>
+#elif defined(__linux__)
+  #include <unistd.h>
+#endif
+
+namespace TinyMinecraft {
+
+  namespace Utils {
+
+    static struct MemoryTrackerData {
+      std::array<std::atomic<int64_t>, MEMORY_CATEGORY_COUNT> current {}, peak {};
+      std::array<std::atomic<bool>, MEMORY_CATEGORY_COUNT> isOverBudget {};
+    } s_data;
+
+    void MemoryTracker::Add(MemoryCategory category, int64_t bytes) {
+      const auto index = static_cast<size_t>(category);
+
+      const int64_t current = s_data.current[index].fetch_add(bytes, std::memory_order_relaxed) + bytes;
+
+      int64_t peak = s_data.peak[index].load(std::memory_order_relaxed);
+      while (current > peak && !s_data.peak[index].compare_exchange_weak(peak, current, std::memory_order_relaxed)) {}
+    }
+
+    auto MemoryTracker::GetStats() -> MemoryStats {
+      MemoryStats stats;
+
+      for (size_t i = 0; i < MEMORY_CATEGORY_COUNT; ++i) {
+        stats.categories[i] = MemoryCategoryStats{
+          s_data.current[i].load(std::memory_order_relaxed),
+          s_data.peak[i].load(std::memory_order_relaxed),
+          GetBudget(static_cast<MemoryCategory>(i)),
+        };
+      }
+
+      stats.residentBytes = GetResidentBytes();
+      return stats;
+    }
+
+    auto MemoryTracker::GetCategoryName(MemoryCategory category) -> const char * {
+      switch (category) {
+        case MemoryCategory::ChunkBlocks:
+          return "Chunk blocks";
+        case MemoryCategory::MeshStaging:
+          return "Mesh staging";
+        case MemoryCategory::GpuBuffers:
+          return "GPU buffers";
+        case MemoryCategory::WorldGenScratch:
+          return "Worldgen scratch";
+        case MemoryCategory::Profiler:
+        default:
+          return "Profiler";
+      }
+    }
+
+    auto MemoryTracker::GetBudget(MemoryCategory category) -> int64_t {
+      switch (category) {
+        case MemoryCategory::ChunkBlocks:
+          return UTILS_MEMORY_BUDGET_CHUNK_BLOCKS;
+        case MemoryCategory::MeshStaging:
+          return UTILS_MEMORY_BUDGET_MESH_STAGING;
+        case MemoryCategory::GpuBuffers:
+          return UTILS_MEMORY_BUDGET_GPU_BUFFERS;
+        case MemoryCategory::WorldGenScratch:
+          return UTILS_MEMORY_BUDGET_WORLDGEN_SCRATCH;
+        case MemoryCategory::Profiler:
+        default:
+          return UTILS_MEMORY_BUDGET_PROFILER;
+      }
+    }
+
+    auto MemoryTracker::GetResidentBytes() -> long long {
+#ifdef __APPLE__
+      mach_task_basic_info info;
+      mach_msg_type_number_t size = MACH_TASK_BASIC_INFO_COUNT;
+      if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &size) == KERN_SUCCESS) {
+        return static_cast<long long>(info.resident_size);
+      }
+      return 0;
+#elif defined(__linux__)
+      // the second field is the current resident set in pages; getrusage only has the peak
+      std::FILE *file = std::fopen("/proc/self/statm", "r");
+      if (!file) {
+        return 0;
+      }
+
+      long long totalPages = 0, residentPages = 0;
+      const bool isRead = std::fscanf(file, "%lld %lld", &totalPages, &residentPages) == 2;
+      std::fclose(file);
+
+      return isRead ? residentPages * static_cast<long long>(sysconf(_SC_PAGESIZE)) : 0;
+#else
+      return 0;
+#endif
+    }
+
+    void MemoryTracker::CheckBudgets() {
+      for (size_t i = 0; i < MEMORY_CATEGORY_COUNT; ++i) {
+        const auto category = static_cast<MemoryCategory>(i);
+        const int64_t budget = GetBudget(category);
+        const int64_t current = s_data.current[i].load(std::memory_order_relaxed);
+
+        if (budget <= 0) {
+          continue;
+        }
+
+        const bool isOverBudget = current > budget;
+        if (s_data.isOverBudget[i].exchange(isOverBudget, std::memory_order_relaxed) || !isOverBudget) {
+          continue;
+        }
+
+        Logger::Warning("{} use {} MB, over their budget of {} MB.", GetCategoryName(category), current >> 20, budget >> 20);
+      }
+    }
+
+    void MemoryTracker::LogSummary() {
+      const MemoryStats stats = GetStats();
+      const auto mb = [](long long bytes) { return static_cast<double>(bytes) / (1024.0 * 1024.0); };
+
+      std::ostringstream oss;
+      oss << std::fixed << std::setprecision(1);
+      oss << "\n\n------ Memory ------\n";
+
+      for (size_t i = 0; i < MEMORY_CATEGORY_COUNT; ++i) {
+        const MemoryCategoryStats &category = stats.categories[i];
+
+        oss << std::setw(18) << std::left << GetCategoryName(static_cast<MemoryCategory>(i))
+            << " | Current: " << std::setw(8) << mb(category.current) << " MB"
+            << " | Peak: " << std::setw(8) << mb(category.peak) << " MB";
+        if (category.budget > 0) {
+          oss << " | Budget: " << mb(category.budget) << " MB";
+        }
+        oss << "\n";
+      }
+
+      oss << "\nResident: " << mb(stats.residentBytes) << " MB\n";
+
+      Logger::Log(Logger::Level::Profile, oss.str());
+    }
+
+  }
+
+}
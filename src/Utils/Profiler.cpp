@@ -1,73 +1,514 @@
 #include "Utils/Profiler.h"
+#include "Utils/LatencyHistogram.h"
 #include "Utils/Logger.h"
-#include <chrono>
+#include "Utils/MemoryTracker.h"
+#include "Utils/utils.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
 #include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <sstream>
-#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace TinyMinecraft {
 
   namespace Utils {
-    
-    std::unordered_map<ProfileCategory, std::unordered_map<std::string, std::vector<ProfileData>>> Profiler::records;
-    std::mutex Profiler::recordMutex;
 
-    Profiler::Profiler(std::string_view section, ProfileCategory category)
-      : m_category(category)
-      , m_name(section)
-      , m_start(std::chrono::high_resolution_clock::now())
-      , m_memoryStart(static_cast<long long>(GetCurrentMemoryUsage()))
-    {}
+    struct ProfileRecord {
+      enum class Type : uint8_t {
+        Scope,
+        Frame,    // start only
+        Counter   // start and value only
+      };
+
+      uint64_t start, end;
+      long long value;        // memory difference of a scope, sample of a counter
+      uint32_t sectionId;
+      Type type;
+#ifdef UTILS_CountAllocations
+      AllocationCount allocations;   // of a scope
+#endif
+    };
+
+    namespace {
+
+      // single producer, the thread that owns it, and single consumer, whoever holds the aggregate mutex
+      struct ThreadBuffer {
+        static constexpr size_t CAPACITY = 4096;
+
+        std::array<ProfileRecord, CAPACITY> records;
+        alignas(64) std::atomic<size_t> head = 0;
+        alignas(64) std::atomic<size_t> tail = 0;
+        uint32_t threadIndex = 0;
+        std::atomic<bool> isRetired = false;
+      };
+
+      // flags the buffer when its thread exits, so the aggregator frees it once drained
+      struct ThreadBufferHandle {
+        ThreadBuffer *buffer = nullptr;
+
+        ~ThreadBufferHandle() {
+          if (buffer) {
+            buffer->isRetired.store(true, std::memory_order_release);
+          }
+        }
+      };
+
+      struct Section {
+        std::string name;
+        ProfileCategory category;
+        LatencyHistogram histogram;
+        long long totalTime = 0;
+        long long totalMemoryDiff = 0;
+        uint64_t totalAllocations = 0, totalAllocatedBytes = 0;
+      };
+
+      struct TraceEvent {
+        ProfileRecord record;
+        uint32_t threadIndex;
+      };
+
+      // every this often the aggregator drains the thread buffers, well before they fill up
+      constexpr auto AGGREGATE_INTERVAL = std::chrono::milliseconds(20);
+
+      thread_local ThreadBufferHandle threadBuffer;
+
+      // section and thread names are identifiers, but keep the file valid whatever they hold
+      void WriteJsonString(std::ostream &out, std::string_view string) {
+        out << '"';
+        for (const char c : string) {
+          if (c == '"' || c == '\\') {
+            out << '\\' << c;
+          } else if (static_cast<unsigned char>(c) >= 0x20) {
+            out << c;
+          }
+        }
+        out << '"';
+      }
+
+      // as a Chrome trace, which chrome://tracing and ui.perfetto.dev open
+      void WriteTrace(
+        const std::vector<TraceEvent> &traceEvents,
+        const std::vector<std::string> &threadNames,
+        const std::vector<std::string> &sectionNames,
+        const std::vector<std::string> &sectionCategories,
+        uint64_t captureStart
+      ) {
+        const std::time_t now = std::time(nullptr);
+        std::ostringstream fileName;
+        fileName << "trace_" << std::put_time(std::localtime(&now), "%Y%m%d_%H%M%S") << ".json";
+
+        std::error_code error;
+        const std::filesystem::path directory("../traces");
+        std::filesystem::create_directories(directory, error);
+
+        const std::filesystem::path path = directory / fileName.str();
+        std::ofstream out(path);
+
+        if (!out.is_open()) {
+          Logger::Warning("Profiler: cannot write trace {}.", path.string());
+          return;
+        }
+
+        // Chrome trace event format, timestamps in microseconds from the start of the capture
+        const auto writeTimestamp = [&](uint64_t timestamp) {
+          out << static_cast<double>(static_cast<int64_t>(timestamp - captureStart)) / 1000.0;
+        };
+
+        out << std::fixed << std::setprecision(3);
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+        for (size_t i = 0; i < threadNames.size(); ++i) {
+          out << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << i << ",\"args\":{\"name\":";
+          WriteJsonString(out, threadNames[i]);
+          out << "}},\n";
+        }
+
+        for (const auto &[record, threadIndex] : traceEvents) {
+          switch (record.type) {
+            case ProfileRecord::Type::Scope:
+              out << "{\"ph\":\"X\",\"name\":";
+              WriteJsonString(out, sectionNames[record.sectionId]);
+              out << ",\"cat\":\"" << sectionCategories[record.sectionId] << "\",\"ts\":";
+              writeTimestamp(record.start);
+              out << ",\"dur\":" << static_cast<double>(record.end - record.start) / 1000.0;
+#ifdef UTILS_CountAllocations
+              out << ",\"args\":{\"allocations\":" << record.allocations.count << ",\"allocated bytes\":" << record.allocations.bytes << "}";
+#endif
+              break;
+            case ProfileRecord::Type::Frame:
+              out << "{\"ph\":\"i\",\"s\":\"g\",\"name\":\"Frame\",\"ts\":";
+              writeTimestamp(record.start);
+              break;
+            case ProfileRecord::Type::Counter:
+              out << "{\"ph\":\"C\",\"name\":";
+              WriteJsonString(out, sectionNames[record.sectionId]);
+              out << ",\"ts\":";
+              writeTimestamp(record.start);
+              out << ",\"args\":{\"value\":" << record.value << "}";
+              break;
+          }
+          out << ",\"pid\":1,\"tid\":" << threadIndex << "},\n";
+        }
+
+        // closes the trailing comma
+        out << "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":1,\"args\":{\"name\":\"TinyMinecraft\"}}\n]}\n";
+
+        Logger::Message("Profiler: wrote {} trace events to {}.", traceEvents.size(), path.string());
+      }
+
+    }
+
+    static struct ProfilerData {
+      std::mutex sectionMutex;
+      std::unordered_map<std::string, uint32_t> sectionIds;
+      std::vector<std::string> sectionNames;
+      std::vector<ProfileCategory> sectionCategories;
+
+      std::mutex bufferMutex;
+      std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+      std::vector<std::string> threadNames;   // by thread index, kept after the thread exits
+
+      // held while draining, which makes the drainer the only consumer of every buffer
+      std::mutex aggregateMutex;
+      std::vector<Section> sections;
+
+      // timeline capture, the events are appended while draining
+      std::atomic<bool> isCapturing = false;
+      uint64_t captureStart = 0, captureEnd = 0;
+      std::vector<TraceEvent> traceEvents;
+
+      // of the sections and trace events, as last reported to the MemoryTracker
+      int64_t trackedBytes = 0;
+
+      std::once_flag aggregatorStarted;
+      std::thread aggregator;
+      std::mutex aggregatorMutex;
+      std::condition_variable aggregatorCondition;
+      bool shouldTerminate = false;
+
+      ~ProfilerData() {
+        {
+          std::lock_guard<std::mutex> lock(aggregatorMutex);
+          shouldTerminate = true;
+        }
+        aggregatorCondition.notify_all();
+
+        if (aggregator.joinable()) {
+          aggregator.join();
+        }
+      }
+    } s_data;
 
     Profiler::~Profiler() {
-      auto end = std::chrono::high_resolution_clock::now();
-      auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - m_start).count();
-      long long memoryEnd = static_cast<long long>(GetCurrentMemoryUsage());
-      long long memDiff = memoryEnd - m_memoryStart;
-
-      Profiler::LogRecord(m_category, m_name, duration, memDiff);
-    }
-
-    auto Profiler::GetCurrentMemoryUsage() -> size_t {
-#ifdef __APPLE__
-      mach_task_basic_info info;
-      mach_msg_type_number_t size = MACH_TASK_BASIC_INFO_COUNT;
-      if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &size) == KERN_SUCCESS) {
-        return info.resident_size;
-      }
-      return 0;
-#elif define (__linux__)
-      struct rusage usage;
-      getrusage(RUSAGE_SELF, &usage);
-      return usage.ru_maxrss * 1024;
+      const uint64_t end = GetTimestamp();
+
+#ifdef UTILS_ProfileMemory
+      const long long memoryDiff = GetCurrentMemoryUsage() - m_memoryStart;
+#else
+      const long long memoryDiff = 0;
+#endif
+
+#ifdef UTILS_CountAllocations
+      const AllocationCount allocations = AllocationCounter::GetThreadCount() - m_allocationsStart;
+      PushRecord(ProfileRecord{ m_start, end, memoryDiff, m_sectionId, ProfileRecord::Type::Scope, allocations });
+#else
+      PushRecord(ProfileRecord{ m_start, end, memoryDiff, m_sectionId, ProfileRecord::Type::Scope });
 #endif
     }
 
-    void Profiler::LogSummary() { 
-      std::lock_guard<std::mutex> lock(recordMutex);
+    void Profiler::PushRecord(const ProfileRecord &record) {
+      ThreadBuffer *buffer = threadBuffer.buffer;
+      if (!buffer) {
+        auto owned = std::make_unique<ThreadBuffer>();
+        buffer = owned.get();
+
+        std::lock_guard<std::mutex> lock(s_data.bufferMutex);
+        buffer->threadIndex = static_cast<uint32_t>(s_data.threadNames.size());
+        s_data.threadNames.push_back(GetThreadName());
+        s_data.buffers.push_back(std::move(owned));
+        threadBuffer.buffer = buffer;
+
+        MemoryTracker::Add(MemoryCategory::Profiler, sizeof(ThreadBuffer));
+      }
+
+      const size_t head = buffer->head.load(std::memory_order_relaxed);
+
+      // only when the aggregator fell behind by a whole buffer, which takes hundreds of thousands of scopes a second
+      if (head - buffer->tail.load(std::memory_order_acquire) == ThreadBuffer::CAPACITY) {
+        std::lock_guard<std::mutex> lock(s_data.aggregateMutex);
+        DrainBuffers();
+      }
+
+      buffer->records[head % ThreadBuffer::CAPACITY] = record;
+      buffer->head.store(head + 1, std::memory_order_release);
+    }
+
+    auto Profiler::RegisterSection(std::string_view name, ProfileCategory category) -> uint32_t {
+      std::call_once(s_data.aggregatorStarted, [] { s_data.aggregator = std::thread(&Profiler::RunAggregatorThread); });
+
+      std::lock_guard<std::mutex> lock(s_data.sectionMutex);
+
+      // call sites with the same name and category share a section, like overloads
+      std::string key(name);
+      key += static_cast<char>('0' + static_cast<int>(category));
+
+      const auto [it, isInserted] = s_data.sectionIds.try_emplace(std::move(key), static_cast<uint32_t>(s_data.sectionNames.size()));
+      if (isInserted) {
+        s_data.sectionNames.emplace_back(name);
+        s_data.sectionCategories.push_back(category);
+      }
+
+      return it->second;
+    }
+
+    void Profiler::MarkFrame() {
+      if (IsCapturing()) {
+        const uint64_t now = GetTimestamp();
+        PushRecord(ProfileRecord{ now, now, 0, 0, ProfileRecord::Type::Frame });
+      }
+    }
+
+    void Profiler::RecordCounter(uint32_t counterId, long long value) {
+      if (IsCapturing()) {
+        const uint64_t now = GetTimestamp();
+        PushRecord(ProfileRecord{ now, now, value, counterId, ProfileRecord::Type::Counter });
+      }
+    }
+
+    auto Profiler::IsCapturing() -> bool {
+      return s_data.isCapturing.load(std::memory_order_relaxed);
+    }
+
+    void Profiler::BeginCapture(float seconds) {
+      std::call_once(s_data.aggregatorStarted, [] { s_data.aggregator = std::thread(&Profiler::RunAggregatorThread); });
+
+      std::lock_guard<std::mutex> lock(s_data.aggregateMutex);
+
+      if (s_data.isCapturing.load()) {
+        return;
+      }
+
+      // what ended before the capture stays out of it
+      DrainBuffers();
+
+      s_data.captureStart = GetTimestamp();
+      s_data.captureEnd = s_data.captureStart + static_cast<uint64_t>(seconds * 1e9f);
+      s_data.traceEvents.clear();
+      s_data.isCapturing.store(true);
+
+      Logger::Message("Profiler: capturing a trace for up to {} s.", seconds);
+    }
+
+    void Profiler::EndCapture() {
+      std::lock_guard<std::mutex> lock(s_data.aggregateMutex);
+
+      // written by the aggregator
+      s_data.captureEnd = std::min(s_data.captureEnd, GetTimestamp());
+    }
+
+    void Profiler::RunAggregatorThread() {
+      SetThreadName("profiler");
+
+      std::unique_lock<std::mutex> lock(s_data.aggregatorMutex);
+      while (!s_data.aggregatorCondition.wait_for(lock, AGGREGATE_INTERVAL, [] { return s_data.shouldTerminate; })) {
+        lock.unlock();
+        Aggregate();
+        lock.lock();
+      }
+    }
+
+    void Profiler::Aggregate() {
+      std::vector<TraceEvent> traceEvents;
+      std::vector<std::string> threadNames;
+      uint64_t captureStart = 0;
+
+      {
+        std::lock_guard<std::mutex> lock(s_data.aggregateMutex);
+        DrainBuffers();
+
+        if (!s_data.isCapturing.load() || GetTimestamp() < s_data.captureEnd) {
+          return;
+        }
+
+        s_data.isCapturing.store(false);
+        traceEvents = std::move(s_data.traceEvents);
+        s_data.traceEvents.clear();
+        captureStart = s_data.captureStart;
+
+        std::lock_guard<std::mutex> bufferLock(s_data.bufferMutex);
+        threadNames = s_data.threadNames;
+      }
+
+      std::vector<std::string> sectionNames, sectionCategories;
+      {
+        std::lock_guard<std::mutex> lock(s_data.sectionMutex);
+        sectionNames = s_data.sectionNames;
+        std::ranges::transform(s_data.sectionCategories, std::back_inserter(sectionCategories), &Profiler::CategoryToString);
+      }
+
+      WriteTrace(traceEvents, threadNames, sectionNames, sectionCategories, captureStart);
+    }
+
+    void Profiler::DrainBuffers() {
+      const auto addNewSections = []() {
+        std::lock_guard<std::mutex> sectionLock(s_data.sectionMutex);
+        for (size_t id = s_data.sections.size(); id < s_data.sectionNames.size(); ++id) {
+          s_data.sections.push_back(Section{ s_data.sectionNames[id], s_data.sectionCategories[id] });
+        }
+      };
+
+      const bool isCapturing = s_data.isCapturing.load();
+
+      std::lock_guard<std::mutex> bufferLock(s_data.bufferMutex);
+
+      std::erase_if(s_data.buffers, [&](const std::unique_ptr<ThreadBuffer> &buffer) {
+        // read before draining, a thread that exits afterwards has nothing left to record
+        const bool isRetired = buffer->isRetired.load(std::memory_order_acquire);
+
+        const size_t head = buffer->head.load(std::memory_order_acquire);
+        size_t tail = buffer->tail.load(std::memory_order_relaxed);
+
+        for (; tail != head; ++tail) {
+          const ProfileRecord &record = buffer->records[tail % ThreadBuffer::CAPACITY];
+
+          if (isCapturing && record.end >= s_data.captureStart && record.start <= s_data.captureEnd) {
+            s_data.traceEvents.push_back(TraceEvent{ record, buffer->threadIndex });
+
+            // bounds the memory of a capture left running
+            if (s_data.traceEvents.size() == UTILS_TRACE_MAX_EVENTS) {
+              s_data.captureEnd = std::min(s_data.captureEnd, record.end);
+            }
+          }
+
+          if (record.type != ProfileRecord::Type::Scope) {
+            continue;
+          }
+
+          const auto duration = static_cast<long long>(record.end - record.start);
+
+          // registered after the last drain
+          if (record.sectionId >= s_data.sections.size()) {
+            addNewSections();
+          }
+
+          Section &section = s_data.sections[record.sectionId];
+          section.histogram.Record(duration);
+          section.totalTime += duration;
+          section.totalMemoryDiff += record.value;
+#ifdef UTILS_CountAllocations
+          section.totalAllocations += record.allocations.count;
+          section.totalAllocatedBytes += record.allocations.bytes;
+#endif
+
+#ifdef UTILS_ProfileVerbose
+          Logger::Log(Logger::Level::Profile, "({}) Time: {} -- Memory: {}", section.name, FormatDuration(duration), FormatMemory(record.value));
+#endif
+        }
+
+        buffer->tail.store(tail, std::memory_order_release);
+
+        if (isRetired) {
+          MemoryTracker::Release(MemoryCategory::Profiler, sizeof(ThreadBuffer));
+        }
+        return isRetired;
+      });
+
+      const auto bytes = static_cast<int64_t>(s_data.sections.capacity() * sizeof(Section) + s_data.traceEvents.capacity() * sizeof(TraceEvent));
+      MemoryTracker::Add(MemoryCategory::Profiler, bytes - std::exchange(s_data.trackedBytes, bytes));
+    }
+
+    auto Profiler::GetCurrentMemoryUsage() -> long long {
+      return MemoryTracker::GetResidentBytes();
+    }
+
+    auto Profiler::Snapshot(bool reset) -> std::vector<ProfileSectionStats> {
+      Aggregate();
+
+      std::lock_guard<std::mutex> lock(s_data.aggregateMutex);
+
+      std::vector<ProfileSectionStats> snapshot;
+      for (Section &section : s_data.sections) {
+        const LatencyHistogram &histogram = section.histogram;
+
+        if (histogram.GetCount() > 0) {
+          snapshot.push_back(ProfileSectionStats{
+            section.name,
+            section.category,
+            histogram.GetCount(),
+            section.totalTime,
+            static_cast<long long>(histogram.GetPercentile(50.0)),
+            static_cast<long long>(histogram.GetPercentile(90.0)),
+            static_cast<long long>(histogram.GetPercentile(99.0)),
+            static_cast<long long>(histogram.GetPercentile(99.9)),
+            static_cast<long long>(histogram.GetMax()),
+            section.totalMemoryDiff,
+            section.totalAllocations,
+            section.totalAllocatedBytes,
+          });
+        }
+
+        if (reset) {
+          section.histogram.Reset();
+          section.totalTime = 0;
+          section.totalMemoryDiff = 0;
+          section.totalAllocations = 0;
+          section.totalAllocatedBytes = 0;
+        }
+      }
+
+      return snapshot;
+    }
+
+    void Profiler::LogSummary(bool reset) {
+      const std::vector<ProfileSectionStats> snapshot = Snapshot(reset);
+
+      std::map<ProfileCategory, std::vector<const ProfileSectionStats *>> categories;
+      for (const ProfileSectionStats &stats : snapshot) {
+        categories[stats.category].push_back(&stats);
+      }
+
       std::ostringstream oss;
       oss << "\n\n------ Profiling Summary ------\n";
-      for (const auto &[cat, sections] : records) {
+      for (const auto &[cat, sections] : categories) {
         oss << "\n\t" << CategoryToString(cat) << "\n";
         oss << std::string(80, '-') << "\n";
-        for (const auto& [section, dataVec] : sections) {
-          long long totalTime = 0;
-          long long totalMemDiff = 0;
-          for (const auto &data : dataVec) {
-            totalTime += data.duration;
-            totalMemDiff += data.memoryDiff;
-          }
-          long long avgTime = totalTime / static_cast<long long>(dataVec.size());
-          long long avgMemDiff = totalMemDiff / static_cast<long long>(dataVec.size());
-          oss << std::setw(40) << std::left << section
-              << " | Runs: " << std::setw(9) << dataVec.size()
-              << " | Avg Time: " << std::setw(12) << FormatDuration(avgTime)
-              << " | Total Time: " << FormatDuration(totalTime)
-              << " | Avg Δ Mem: " << std::setw(12) << FormatMemory(avgMemDiff)
-              << " | Total Δ Mem: " << FormatMemory(totalMemDiff)
-              << "\n";
+        for (const ProfileSectionStats *stats : sections) {
+          oss << std::setw(40) << std::left << stats->name
+              << " | Runs: " << std::setw(9) << stats->count
+              << " | p50: " << std::setw(8) << FormatDuration(stats->p50)
+              << " | p90: " << std::setw(8) << FormatDuration(stats->p90)
+              << " | p99: " << std::setw(8) << FormatDuration(stats->p99)
+              << " | p99.9: " << std::setw(8) << FormatDuration(stats->p999)
+              << " | Max: " << std::setw(8) << FormatDuration(stats->max)
+              << " | Total Time: " << FormatDuration(stats->totalTime);
+#ifdef UTILS_ProfileMemory
+          long long avgMemDiff = stats->totalMemoryDiff / static_cast<long long>(stats->count);
+          oss << " | Avg Δ Mem: " << std::setw(12) << FormatMemory(avgMemDiff)
+              << " | Total Δ Mem: " << FormatMemory(stats->totalMemoryDiff);
+#endif
+#ifdef UTILS_CountAllocations
+          const auto runs = static_cast<double>(stats->count);
+          oss << std::fixed << std::setprecision(1)
+              << " | Allocs/Run: " << std::setw(8) << static_cast<double>(stats->totalAllocations) / runs
+              << " | Bytes/Run: " << std::setw(10) << FormatMemory(static_cast<long long>(static_cast<double>(stats->totalAllocatedBytes) / runs))
+              << std::defaultfloat;
+#endif
+          oss << "\n";
         }
       }
+
       Logger::Log(Logger::Level::Profile, oss.str());
     }
 
@@ -100,16 +541,7 @@ namespace TinyMinecraft {
       return oss.str();
     }
 
-    void Profiler::LogRecord(ProfileCategory cat, const std::string &section, long long duration, long long memDiff) {
-      std::lock_guard<std::mutex> lock(recordMutex);
-      records[cat][section].push_back({ duration, memDiff });
-
-#ifdef UTILS_ProfileVerbose
-      Logger::Log(Logger::Level::Profile, "({}) Time: {} -- Memory: {}", section, FormatDuration(duration), FormatMemory(memDiff));
-#endif
-    }
-
-    auto Profiler::CategoryToString(ProfileCategory cat) -> std::string { 
+    auto Profiler::CategoryToString(ProfileCategory cat) -> std::string {
       switch (cat) {
         case ProfileCategory::Window:
           return "Window";
@@ -0,0 +1,508 @@
+#include "Utils/SamplingProfiler.h"
+
+#include "Utils/Logger.h"
+#include "Utils/utils.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#ifdef __linux__
+  #include <cxxabi.h>
+  #include <dlfcn.h>
+  #include <execinfo.h>
+  #include <linux/perf_event.h>
+  #include <signal.h>
+  #include <sys/ioctl.h>
+  #include <sys/mman.h>
+  #include <sys/syscall.h>
+  #include <sys/time.h>
+  #include <unistd.h>
+#endif
+
+namespace TinyMinecraft {
+
+  namespace Utils {
+
+#ifdef __linux__
+
+    namespace {
+
+      constexpr int MAX_DEPTH = 64;
+      constexpr auto DRAIN_INTERVAL = std::chrono::milliseconds(10);
+
+      // a stack, innermost frame first, and the thread it was sampled on
+      struct StackKey {
+        pid_t tid;
+        std::vector<uintptr_t> frames;
+
+        auto operator<(const StackKey &other) const -> bool {
+          return tid != other.tid ? tid < other.tid : frames < other.frames;
+        }
+      };
+
+      // perf_event_open, one event and ring buffer per thread
+      struct PerfThread {
+        pid_t tid;
+        int fd;
+        void *buffer;
+      };
+
+      constexpr size_t PERF_DATA_PAGES = 16;
+
+      // SIGPROF, written by the signal handler of whichever thread was running: a bounded multi-producer queue
+      // that only uses atomics, so it is safe to fill from a signal handler
+      struct SignalSample {
+        std::atomic<size_t> sequence;
+        pid_t tid;
+        int depth;
+        void *frames[MAX_DEPTH + 2];
+      };
+
+      constexpr size_t SIGNAL_QUEUE_SIZE = 4096;
+
+      struct SignalQueue {
+        std::array<SignalSample, SIGNAL_QUEUE_SIZE> samples;
+        std::atomic<size_t> enqueuePos = 0;
+        size_t dequeuePos = 0;
+      };
+
+      void HandleProfilingSignal(int);
+
+    }
+
+    static struct SamplingProfilerData {
+      std::mutex mutex;
+      std::atomic<bool> isRunning = false;
+      bool usesPerf = false;
+
+      std::thread sampler;
+      std::atomic<bool> shouldStop = false;
+      int frequency = 0;
+
+      std::vector<PerfThread> perfThreads;
+      std::unique_ptr<SignalQueue> signalQueue;
+      std::atomic<size_t> droppedCount = 0;
+
+      std::map<StackKey, uint64_t> stacks;
+      std::unordered_map<pid_t, std::string> threadNames;
+    } s_data;
+
+    namespace {
+
+      void HandleProfilingSignal(int) {
+        SignalQueue *queue = s_data.signalQueue.get();
+        if (!queue) {
+          return;
+        }
+
+        size_t pos = queue->enqueuePos.load(std::memory_order_relaxed);
+        SignalSample *sample = nullptr;
+
+        while (true) {
+          sample = &queue->samples[pos % SIGNAL_QUEUE_SIZE];
+          const auto difference = static_cast<std::ptrdiff_t>(sample->sequence.load(std::memory_order_acquire) - pos);
+
+          if (difference == 0) {
+            if (queue->enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+              break;
+            }
+          } else if (difference < 0) {
+            s_data.droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return;
+          } else {
+            pos = queue->enqueuePos.load(std::memory_order_relaxed);
+          }
+        }
+
+        sample->tid = static_cast<pid_t>(syscall(SYS_gettid));
+        sample->depth = backtrace(sample->frames, MAX_DEPTH + 2);
+        sample->sequence.store(pos + 1, std::memory_order_release);
+      }
+
+      auto ReadThreadName(pid_t tid) -> std::string {
+        std::ifstream comm("/proc/self/task/" + std::to_string(tid) + "/comm");
+        std::string name;
+        std::getline(comm, name);
+        return name.empty() ? "thread " + std::to_string(tid) : name;
+      }
+
+      auto OpenPerfEvent(pid_t tid, int frequency) -> int {
+        perf_event_attr attr {};
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_SOFTWARE;
+        attr.config = PERF_COUNT_SW_TASK_CLOCK;
+        attr.freq = 1;
+        attr.sample_freq = static_cast<uint64_t>(frequency);
+        attr.sample_type = PERF_SAMPLE_TID | PERF_SAMPLE_CALLCHAIN;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.exclude_callchain_kernel = 1;
+
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, tid, -1, -1, PERF_FLAG_FD_CLOEXEC));
+      }
+
+      // opens an event on every thread that does not have one yet; threads started later are found on the next call
+      void AttachPerfThreads() {
+        for (const auto &entry : std::filesystem::directory_iterator("/proc/self/task")) {
+          const auto tid = static_cast<pid_t>(std::stoi(entry.path().filename().string()));
+
+          if (std::ranges::any_of(s_data.perfThreads, [tid](const PerfThread &thread) { return thread.tid == tid; })) {
+            continue;
+          }
+
+          const int fd = OpenPerfEvent(tid, s_data.frequency);
+          if (fd < 0) {
+            continue;
+          }
+
+          const size_t size = (PERF_DATA_PAGES + 1) * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+          void *buffer = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+          if (buffer == MAP_FAILED) {
+            close(fd);
+            continue;
+          }
+
+          s_data.perfThreads.push_back(PerfThread{ tid, fd, buffer });
+        }
+      }
+
+      void DetachPerfThreads() {
+        const size_t size = (PERF_DATA_PAGES + 1) * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+
+        for (const PerfThread &thread : s_data.perfThreads) {
+          munmap(thread.buffer, size);
+          close(thread.fd);
+        }
+
+        s_data.perfThreads.clear();
+      }
+
+      void DrainPerfThreads() {
+        const auto pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        const size_t dataSize = PERF_DATA_PAGES * pageSize;
+
+        std::vector<uint8_t> record;
+
+        for (const PerfThread &thread : s_data.perfThreads) {
+          auto *header = static_cast<perf_event_mmap_page *>(thread.buffer);
+          const uint8_t *data = static_cast<const uint8_t *>(thread.buffer) + pageSize;
+
+          const uint64_t head = __atomic_load_n(&header->data_head, __ATOMIC_ACQUIRE);
+          uint64_t tail = header->data_tail;
+
+          while (tail < head) {
+            // records may wrap around the end of the buffer
+            const auto copy = [&](uint64_t offset, size_t size) {
+              record.resize(size);
+              for (size_t i = 0; i < size; ++i) {
+                record[i] = data[(offset + i) % dataSize];
+              }
+            };
+
+            copy(tail, sizeof(perf_event_header));
+            const perf_event_header eventHeader = *reinterpret_cast<const perf_event_header *>(record.data());
+
+            if (eventHeader.size < sizeof(perf_event_header)) {
+              tail = head;
+              break;
+            }
+
+            if (eventHeader.type == PERF_RECORD_SAMPLE) {
+              copy(tail, eventHeader.size);
+
+              // PERF_SAMPLE_TID then PERF_SAMPLE_CALLCHAIN
+              const auto *fields = reinterpret_cast<const uint64_t *>(record.data() + sizeof(perf_event_header));
+              const auto tid = static_cast<pid_t>(fields[0] >> 32);
+              const uint64_t count = fields[1];
+
+              StackKey key { tid, {} };
+              for (uint64_t i = 0; i < count && key.frames.size() < MAX_DEPTH; ++i) {
+                // context markers like PERF_CONTEXT_USER
+                if (fields[2 + i] < PERF_CONTEXT_MAX) {
+                  key.frames.push_back(static_cast<uintptr_t>(fields[2 + i]));
+                }
+              }
+
+              ++s_data.stacks[std::move(key)];
+            }
+
+            tail += eventHeader.size;
+          }
+
+          __atomic_store_n(&header->data_tail, tail, __ATOMIC_RELEASE);
+        }
+      }
+
+      void DrainSignalQueue() {
+        SignalQueue &queue = *s_data.signalQueue;
+
+        while (true) {
+          SignalSample &sample = queue.samples[queue.dequeuePos % SIGNAL_QUEUE_SIZE];
+          if (sample.sequence.load(std::memory_order_acquire) != queue.dequeuePos + 1) {
+            break;
+          }
+
+          // the first two frames are the handler and the signal trampoline
+          StackKey key { sample.tid, {} };
+          for (int i = 2; i < sample.depth; ++i) {
+            key.frames.push_back(reinterpret_cast<uintptr_t>(sample.frames[i]));
+          }
+
+          ++s_data.stacks[std::move(key)];
+
+          sample.sequence.store(queue.dequeuePos + SIGNAL_QUEUE_SIZE, std::memory_order_release);
+          ++queue.dequeuePos;
+        }
+      }
+
+      void RefreshThreadNames() {
+        for (const auto &entry : std::filesystem::directory_iterator("/proc/self/task")) {
+          const auto tid = static_cast<pid_t>(std::stoi(entry.path().filename().string()));
+          s_data.threadNames[tid] = ReadThreadName(tid);
+        }
+      }
+
+      void RunSampler() {
+        SetThreadName("sampler");
+
+        int iteration = 0;
+        while (!s_data.shouldStop.load()) {
+          std::this_thread::sleep_for(DRAIN_INTERVAL);
+
+          // thread names are set after the threads start, and new threads may need an event
+          if (iteration++ % 50 == 0) {
+            RefreshThreadNames();
+
+            if (s_data.usesPerf) {
+              AttachPerfThreads();
+            }
+          }
+
+          if (s_data.usesPerf) {
+            DrainPerfThreads();
+          } else {
+            DrainSignalQueue();
+          }
+        }
+      }
+
+      auto Symbolize(uintptr_t address) -> std::string {
+        Dl_info info {};
+        if (dladdr(reinterpret_cast<void *>(address), &info) == 0) {
+          std::ostringstream oss;
+          oss << "0x" << std::hex << address;
+          return oss.str();
+        }
+
+        if (info.dli_sname) {
+          int status = 0;
+          char *demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+          std::string name = status == 0 && demangled ? demangled : info.dli_sname;
+          std::free(demangled);
+          return name;
+        }
+
+        const std::string module = info.dli_fname ? std::filesystem::path(info.dli_fname).filename().string() : "?";
+
+        // not exported: our own static functions keep their offset for addr2line, the internals of libraries are
+        // merged into one frame per library
+        static const void *executableBase = []() {
+          Dl_info self {};
+          dladdr(reinterpret_cast<void *>(&Symbolize), &self);
+          return self.dli_fbase;
+        }();
+
+        if (info.dli_fbase != executableBase) {
+          return module;
+        }
+
+        std::ostringstream oss;
+        oss << module << "+0x" << std::hex << (address - reinterpret_cast<uintptr_t>(info.dli_fbase));
+        return oss.str();
+      }
+
+      void WriteFoldedStacks() {
+        const std::time_t now = std::time(nullptr);
+        std::ostringstream fileName;
+        fileName << "samples_" << std::put_time(std::localtime(&now), "%Y%m%d_%H%M%S") << ".folded";
+
+        std::error_code error;
+        const std::filesystem::path directory("../traces");
+        std::filesystem::create_directories(directory, error);
+
+        const std::filesystem::path path = directory / fileName.str();
+        std::ofstream out(path);
+
+        if (!out.is_open()) {
+          Logger::Warning("Sampling profiler: cannot write {}.", path.string());
+          return;
+        }
+
+        std::unordered_map<uintptr_t, std::string> symbols;
+        // stacks that only differ within a function or library fold into one line
+        std::map<std::string, uint64_t> folded;
+        uint64_t sampleCount = 0;
+
+        for (const auto &[key, count] : s_data.stacks) {
+          const auto name = s_data.threadNames.find(key.tid);
+          std::string line = name != s_data.threadNames.end() ? name->second : "thread " + std::to_string(key.tid);
+
+          for (auto frame = key.frames.rbegin(); frame != key.frames.rend(); ++frame) {
+            // return addresses point past the call, which may already be the next function
+            const uintptr_t address = frame == key.frames.rend() - 1 ? *frame : *frame - 1;
+
+            auto symbol = symbols.find(address);
+            if (symbol == symbols.end()) {
+              symbol = symbols.emplace(address, Symbolize(address)).first;
+            }
+
+            // ';' separates frames in the folded format
+            line += ';';
+            for (const char c : symbol->second) {
+              line += c == ';' ? ':' : c;
+            }
+          }
+
+          folded[line] += count;
+          sampleCount += count;
+        }
+
+        for (const auto &[line, count] : folded) {
+          out << line << ' ' << count << '\n';
+        }
+
+        Logger::Message("Sampling profiler: wrote {} samples, {} dropped, to {}.", sampleCount, s_data.droppedCount.load(), path.string());
+      }
+
+    }
+
+    auto SamplingProfiler::Start(int frequency) -> bool {
+      std::lock_guard<std::mutex> lock(s_data.mutex);
+
+      if (s_data.isRunning.load()) {
+        return true;
+      }
+
+      s_data.frequency = frequency;
+      s_data.stacks.clear();
+      s_data.threadNames.clear();
+      s_data.droppedCount.store(0);
+      s_data.shouldStop.store(false);
+
+      AttachPerfThreads();
+      s_data.usesPerf = !s_data.perfThreads.empty();
+
+      // perf events count from when they are opened
+      if (!s_data.usesPerf) {
+        if (!s_data.signalQueue) {
+          s_data.signalQueue = std::make_unique<SignalQueue>();
+        }
+
+        SignalQueue &queue = *s_data.signalQueue;
+        for (size_t i = 0; i < SIGNAL_QUEUE_SIZE; ++i) {
+          queue.samples[i].sequence.store(i);
+        }
+        queue.enqueuePos.store(0);
+        queue.dequeuePos = 0;
+
+        // the first backtrace loads the unwinder, which must not happen in the handler
+        void *frames[1];
+        backtrace(frames, 1);
+
+        struct sigaction action {};
+        action.sa_handler = HandleProfilingSignal;
+        action.sa_flags = SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        struct sigaction previousAction {};
+        sigaction(SIGPROF, &action, &previousAction);
+
+        const long interval = std::max(1L, 1000000L / frequency);
+        itimerval timer {};
+        timer.it_interval.tv_sec = interval / 1000000;
+        timer.it_interval.tv_usec = interval % 1000000;
+        timer.it_value = timer.it_interval;
+
+        if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+          sigaction(SIGPROF, &previousAction, nullptr);
+          Logger::Warning("Sampling profiler: neither perf events nor SIGPROF are available.");
+          return false;
+        }
+      }
+
+      s_data.sampler = std::thread(RunSampler);
+      s_data.isRunning.store(true);
+
+      Logger::Message("Sampling profiler: sampling at {} Hz with {}.", frequency, s_data.usesPerf ? "perf events" : "SIGPROF");
+      return true;
+    }
+
+    void SamplingProfiler::Stop() {
+      std::lock_guard<std::mutex> lock(s_data.mutex);
+
+      if (!s_data.isRunning.load()) {
+        return;
+      }
+
+      // the sampler attaches new threads to perfThreads, so it goes first
+      s_data.shouldStop.store(true);
+      s_data.sampler.join();
+
+      RefreshThreadNames();
+
+      if (s_data.usesPerf) {
+        for (const PerfThread &thread : s_data.perfThreads) {
+          ioctl(thread.fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+
+        DrainPerfThreads();
+        DetachPerfThreads();
+      } else {
+        const itimerval timer {};
+        setitimer(ITIMER_PROF, &timer, nullptr);
+
+        DrainSignalQueue();
+        // a signal already on its way finds no handler left to run
+        signal(SIGPROF, SIG_IGN);
+      }
+
+      s_data.isRunning.store(false);
+      WriteFoldedStacks();
+    }
+
+    auto SamplingProfiler::IsRunning() -> bool {
+      return s_data.isRunning.load();
+    }
+
+#else
+
+    auto SamplingProfiler::Start(int) -> bool {
+      Logger::Warning("Sampling profiler: only available on Linux.");
+      return false;
+    }
+
+    void SamplingProfiler::Stop() {}
+
+    auto SamplingProfiler::IsRunning() -> bool {
+      return false;
+    }
+
+#endif
+
+  }
+
+}
@@ -14,7 +14,9 @@ namespace TinyMinecraft {
       , m_maxTemp(maxTemp)
       , m_minHumidity(minHumidity)
       , m_maxHumidity(maxHumidity)
-    {}
+    {
+      m_surfaceRules = CompileSurfaceRules();
+    }
 
     auto Biome::IsValid(double temperature, double humidity) const -> bool {
       return temperature >= m_minTemp && temperature <= m_maxTemp &&
@@ -22,8 +24,8 @@ namespace TinyMinecraft {
     }
 
     auto Biome::GenerateBlock(int x, int y, int z, int height, double stoneNoise) const -> BlockType {
-      const int seaLevel = 62;
-      const float stoneThreshold = 0.75;
+      const int seaLevel = SEA_LEVEL;
+      const float stoneThreshold = STONE_THRESHOLD;
       if (height < seaLevel && y > height && y <= seaLevel) return BlockType::Water;
 
       switch(m_type) {
@@ -88,6 +90,49 @@ namespace TinyMinecraft {
       return BlockType::Air;
     }
 
+    // Must stay in sync with `GenerateBlock`: each case lists the layers that function returns for
+    // y <= height, from the surface down.
+    auto Biome::CompileSurfaceRules() const -> SurfaceRules {
+      SurfaceRules rules;
+
+      const auto addLayer = [&rules](BlockType block, int depth) {
+        rules.layers[rules.layerCount++] = SurfaceLayer{ block, depth };
+      };
+
+      switch (m_type) {
+        case BiomeType::Desert:
+          addLayer(BlockType::Sand, 3);
+          break;
+        case BiomeType::Grassland:
+        case BiomeType::Savanna:
+          rules.hasStoneOutcrops = true;
+          rules.shoreBlock = BlockType::Sand;
+          addLayer(BlockType::Grass, 1);
+          addLayer(BlockType::Dirt, 4);
+          break;
+        case BiomeType::Swamp:
+          rules.shoreBlock = BlockType::Sand;
+          addLayer(BlockType::Grass, 1);
+          addLayer(BlockType::Dirt, 2);
+          break;
+        case BiomeType::Tundra:
+          addLayer(BlockType::Snow, 3);
+          addLayer(BlockType::Dirt, 3);
+          break;
+        case BiomeType::Taiga:
+        case BiomeType::Forest:
+          addLayer(BlockType::Log, 3);
+          addLayer(BlockType::Dirt, 3);
+          break;
+        case BiomeType::Shrubland:
+          addLayer(BlockType::Grass, 3);
+          addLayer(BlockType::Dirt, 3);
+          break;
+      }
+
+      return rules;
+    }
+
     auto Biome::GetType() const -> BiomeType {
       return m_type;
     }
@@ -26,6 +26,17 @@ namespace TinyMinecraft {
       LoadBlockData(BlockType::TallGrass,   "../data/block/11_tallgrass.json");
     }
 
+    auto BlockData::FromName(const std::string &name, BlockType &block) -> bool {
+      for (const auto &[type, definition] : data) {
+        if (definition.name == name) {
+          block = type;
+          return true;
+        }
+      }
+
+      return false;
+    }
+
     void BlockData::LoadBlockData(BlockType block, const std::string &path) {
       std::ifstream file(path);
 
@@ -12,7 +12,10 @@
 #include "World/World.h"
 #include "glm/geometric.hpp"
 #include <algorithm>
+#include <bitset>
+#include <cstdlib>
 #include <memory>
+#include <utility>
 
 namespace TinyMinecraft {
 
@@ -21,18 +24,28 @@ namespace TinyMinecraft {
     Chunk::Chunk(World &world, const glm::ivec2 &m_chunkPos)
       : m_world(world)
       , m_chunkPos(m_chunkPos)
-    {
-      m_opaqueMesh = std::make_unique<Geometry::Mesh>();
-      m_translucentMesh = std::make_unique<Geometry::Mesh>();
+    {}
+
+    Chunk::~Chunk() {
+      Utils::MemoryTracker::Release(Utils::MemoryCategory::ChunkBlocks, GetBlockBytes());
+
+      for (std::atomic<FeatureBatch *> &slot : m_featureInbox) {
+        delete slot.exchange(nullptr);
+      }
     }
 
     Chunk::Chunk(Chunk &&other) noexcept
       : m_world(other.m_world)
       , m_data(std::move(other.m_data))
-      , m_opaqueMesh(std::move(other.m_opaqueMesh))
       , m_translucentMesh(std::move(other.m_translucentMesh))
+      , m_translucentGeometry(std::move(other.m_translucentGeometry))
       , m_chunkPos(other.m_chunkPos)
-    {}
+      , m_featureBatches(std::move(other.m_featureBatches))
+    {
+      for (size_t i = 0; i < m_featureInbox.size(); ++i) {
+        m_featureInbox[i].store(other.m_featureInbox[i].exchange(nullptr));
+      }
+    }
 
     // Move assignment operator
     auto Chunk::operator=(Chunk &&other) noexcept -> Chunk & {
@@ -41,55 +54,381 @@ namespace TinyMinecraft {
       return *this;
     }
 
-    void Chunk::UpdateMesh() {
+    void Chunk::RecordTransition(ChunkState from, ChunkState to) {
+      const uint64_t now = ChunkLifecycle::GetTimestamp();
+
+      if (const auto stage = ChunkLifecycle::GetStage(from)) {
+        const uint64_t startedAt = m_stageStartedAt.load(std::memory_order_relaxed);
+        ChunkLifecycle::RecordStage(*stage, m_stageQueuedAt.load(std::memory_order_relaxed), startedAt, now);
+
+        if (startedAt > 0 && now > startedAt) {
+          m_workTime.fetch_add(now - startedAt, std::memory_order_relaxed);
+        }
+      }
+
+      if (ChunkLifecycle::GetStage(to)) {
+        m_stageQueuedAt.store(now, std::memory_order_relaxed);
+        m_stageStartedAt.store(0, std::memory_order_relaxed);
+      }
+
+      if (from == ChunkState::Empty) {
+        m_requestedAt.store(now, std::memory_order_relaxed);
+        m_workTime.store(0, std::memory_order_relaxed);
+        m_wasDrawn.store(false, std::memory_order_relaxed);
+      }
+
+      // back to Empty after unloading: everything done for it since it was requested was thrown away undrawn
+      if (to == ChunkState::Empty && !m_wasDrawn.load(std::memory_order_relaxed)) {
+        ChunkLifecycle::RecordUndrawnUnload(m_workTime.load(std::memory_order_relaxed));
+      }
+    }
+
+    auto Chunk::UpdateMesh(int level, const glm::vec3 &playerPos) -> std::shared_ptr<const ChunkMesh> {
       PROFILE_FUNCTION(Chunk)
 
+      auto mesh = std::make_shared<ChunkMesh>();
       GLuint indexOffset = 0;
 
-      m_hasTranslucentBlocks = false;
+      bool hasTranslucentBlocks = false;
 
-      for (int z = 0; z < CHUNK_LENGTH; ++z) {
-        for (int y = 0; y < CHUNK_HEIGHT; ++y) {
-          for (int x = 0; x < CHUNK_WIDTH; ++x) {
+      int minHeight = CHUNK_HEIGHT - 1;
+      int maxHeight = 0;
+
+      for (int x = 0; x < CHUNK_WIDTH; ++x) {
+        for (int z = 0; z < CHUNK_LENGTH; ++z) {
+          for (int y = 0; y < CHUNK_HEIGHT; ++y) {
             const glm::vec3 pos = glm::vec3(x, y, z);
             const BlockType block = GetBlockAt(pos);
             
             if (BlockData::IsEmpty(block)) continue;
 
+            minHeight = std::min(minHeight, y);
+            maxHeight = std::max(maxHeight, y);
+
             if (BlockData::IsTranslucent(block)) {
-              m_hasTranslucentBlocks = true;
+              hasTranslucentBlocks = true;
               continue;
             }
 
+            if (level > 0) continue;
+
             BlockRenderType renderType = BlockData::Get(block).renderType;
             if (renderType == BlockRenderType::Standard  || renderType == BlockRenderType::Fluid) {
-              AppendOpaqueBlockGeometry(block, pos, indexOffset, m_opaqueVertices, m_opaqueIndices);
+              AppendOpaqueBlockGeometry(block, pos, indexOffset, mesh->vertices, mesh->indices);
             } else if (renderType == BlockRenderType::Fluid) {
-              AppendOpaqueFluidGeometry(block, pos, indexOffset, m_opaqueVertices, m_opaqueIndices);
+              AppendOpaqueFluidGeometry(block, pos, indexOffset, mesh->vertices, mesh->indices);
             } else if (renderType == BlockRenderType::Foliage) {
-              AppendFoliageGeometry(block, pos, indexOffset, m_opaqueVertices, m_opaqueIndices);
+              AppendFoliageGeometry(block, pos, indexOffset, mesh->vertices, mesh->indices);
+            }
+          }
+        }
+      }
+
+      m_minHeight = std::min(minHeight, maxHeight);
+      m_maxHeight = maxHeight;
+      m_meshLevel = level;
+
+      if (level > 0) {
+        AppendLodGeometry(level, indexOffset, *mesh);
+
+        // cells can stick out of the blocks they were merged from
+        const int size = 1 << level;
+        m_minHeight = m_minHeight / size * size;
+        m_maxHeight = std::min(CHUNK_HEIGHT - 1, (m_maxHeight / size + 1) * size - 1);
+      }
+
+      ChunkVisibility &visibility = mesh->visibility;
+      for (int section = 0; section < CHUNK_SECTION_COUNT; ++section) {
+        visibility.connectivity[section] = ComputeSectionConnectivity(section);
+      }
+      visibility.minHeight = m_minHeight;
+      visibility.maxHeight = m_maxHeight;
+      visibility.hasTranslucentBlocks = hasTranslucentBlocks;
+
+      if (hasTranslucentBlocks) {
+        mesh->translucent = BuildTranslucentGeometry(playerPos);
+      }
+
+      mesh->TrackMemory();
+      return mesh;
+    }
+
+    auto Chunk::ComputeSectionConnectivity(int section) -> SectionConnectivity {
+      constexpr int CELL_COUNT = CHUNK_WIDTH * CHUNK_LENGTH * CHUNK_SECTION_HEIGHT;
+      // same column-major order as the block array, restricted to the section
+      constexpr auto GetCellIndex = [](int x, int y, int z) {
+        return (x * CHUNK_LENGTH + z) * CHUNK_SECTION_HEIGHT + y;
+      };
+
+      if (m_data.blocks.empty()) {
+        return SECTION_FULLY_CONNECTED;
+      }
+
+      const int baseY = section * CHUNK_SECTION_HEIGHT;
+
+      // occluding cells start out visited so the flood fill never enters them
+      std::bitset<CELL_COUNT> visited;
+      for (int x = 0; x < CHUNK_WIDTH; ++x) {
+        for (int z = 0; z < CHUNK_LENGTH; ++z) {
+          for (int y = 0; y < CHUNK_SECTION_HEIGHT; ++y) {
+            const BlockType block = m_data.blocks[CHUNK_INDEX_AT(x, baseY + y, z)];
+            if (BlockData::IsSolid(block) && !BlockData::IsTranslucent(block)) {
+              visited.set(GetCellIndex(x, y, z));
+            }
+          }
+        }
+      }
+
+      if (visited.none()) {
+        return SECTION_FULLY_CONNECTED;
+      }
+
+      if (visited.all()) {
+        return 0;
+      }
+
+      const std::array<glm::ivec3, 6> neighborOffsets = {
+        glm::ivec3(0, 1, 0), glm::ivec3(0, -1, 0), glm::ivec3(1, 0, 0), glm::ivec3(-1, 0, 0), glm::ivec3(0, 0, 1), glm::ivec3(0, 0, -1)
+      };
+
+      SectionConnectivity connectivity = 0;
+      std::vector<glm::ivec3> stack;
+
+      for (int start = 0; start < CELL_COUNT; ++start) {
+        if (visited[start]) {
+          continue;
+        }
+
+        // faces touched by this connected region of open cells
+        uint8_t faces = 0;
+
+        visited.set(start);
+        stack.emplace_back(start / (CHUNK_LENGTH * CHUNK_SECTION_HEIGHT), start % CHUNK_SECTION_HEIGHT, (start / CHUNK_SECTION_HEIGHT) % CHUNK_LENGTH);
+
+        while (!stack.empty()) {
+          const glm::ivec3 cell = stack.back();
+          stack.pop_back();
+
+          if (cell.y == CHUNK_SECTION_HEIGHT - 1) faces |= 1 << Geometry::Face::Top;
+          if (cell.y == 0)                        faces |= 1 << Geometry::Face::Bottom;
+          if (cell.x == CHUNK_WIDTH - 1)          faces |= 1 << Geometry::Face::East;
+          if (cell.x == 0)                        faces |= 1 << Geometry::Face::West;
+          if (cell.z == CHUNK_LENGTH - 1)         faces |= 1 << Geometry::Face::North;
+          if (cell.z == 0)                        faces |= 1 << Geometry::Face::South;
+
+          for (const glm::ivec3 &offset : neighborOffsets) {
+            const glm::ivec3 next = cell + offset;
+
+            if (next.x < 0 || next.y < 0 || next.z < 0 || next.x >= CHUNK_WIDTH || next.y >= CHUNK_SECTION_HEIGHT || next.z >= CHUNK_LENGTH) {
+              continue;
+            }
+
+            const int index = GetCellIndex(next.x, next.y, next.z);
+            if (!visited[index]) {
+              visited.set(index);
+              stack.push_back(next);
+            }
+          }
+        }
+
+        for (int a = 0; a < 6; ++a) {
+          for (int b = 0; b < 6; ++b) {
+            if ((faces >> a & 1) && (faces >> b & 1)) {
+              connectivity |= 1ull << (a * 6 + b);
             }
           }
         }
       }
+
+      return connectivity;
     }
 
-    void Chunk::BufferVertices() {
-      m_opaqueMesh->Update(m_opaqueVertices, m_opaqueIndices);
+    // blocks that vote in LOD cells; foliage and translucent blocks are too thin or see-through to keep
+    static auto IsCellOpaque(BlockType block) -> bool {
+      const BlockRenderType renderType = BlockData::Get(block).renderType;
+      return (renderType == BlockRenderType::Standard || renderType == BlockRenderType::Fluid) && !BlockData::IsTranslucent(block);
     }
- 
-    void Chunk::BufferTranslucentVertices(){
-      m_translucentMesh->Update(m_translucentVertices, m_translucentIndices);
+
+    // same rule IsFaceVisible applies to the faces of opaque blocks
+    static auto HidesOpaqueFace(BlockType neighbor) -> bool {
+      return neighbor != BlockType::Air && !BlockData::IsTranslucent(neighbor);
+    }
+
+    static auto GetCellIndex(int level, const glm::ivec3 &cell) -> int {
+      return (cell.x * (CHUNK_LENGTH >> level) + cell.z) * (CHUNK_HEIGHT >> level) + cell.y;
     }
 
-    void Chunk::UpdateTranslucentMesh(const glm::vec3 &playerPos) {
+    auto Chunk::GetCellBlock(int level, const glm::ivec3 &cell) -> BlockType {
+      const int size = 1 << level;
+      const glm::ivec3 origin = cell * size;
+
+      int opaqueCount = 0;
+      int topY = -1;
+      BlockType top = BlockType::Air;
+
+      for (int x = 0; x < size; ++x) {
+        for (int z = 0; z < size; ++z) {
+          for (int y = 0; y < size; ++y) {
+            const BlockType block = m_data.blocks[CHUNK_INDEX_AT(origin.x + x, origin.y + y, origin.z + z)];
+            if (!IsCellOpaque(block)) continue;
+
+            ++opaqueCount;
+
+            // the top block is what shows from afar, e.g. grass over dirt
+            if (y > topY) {
+              topY = y;
+              top = block;
+            }
+          }
+        }
+      }
+
+      return opaqueCount * 2 >= size * size * size ? top : BlockType::Air;
+    }
+
+    void Chunk::AppendLodGeometry(int level, GLuint &indexOffset, ChunkMesh &mesh) {
       PROFILE_FUNCTION(Chunk)
 
-      m_data.translucentFaces.clear();
+      if (m_data.blocks.empty()) {
+        return;
+      }
+
+      const int size = 1 << level;
+      const glm::ivec3 cellCount(CHUNK_WIDTH >> level, CHUNK_HEIGHT >> level, CHUNK_LENGTH >> level);
 
-      for (int z = 0; z < CHUNK_LENGTH; ++z) {
-        for (int y = 0; y < CHUNK_HEIGHT; ++y) {
-          for (int x = 0; x < CHUNK_WIDTH; ++x) {
+      std::vector<BlockType> cells(static_cast<size_t>(cellCount.x * cellCount.y * cellCount.z), BlockType::Air);
+
+      for (int x = 0; x < cellCount.x; ++x) {
+        for (int z = 0; z < cellCount.z; ++z) {
+          for (int y = m_minHeight / size; y <= m_maxHeight / size; ++y) {
+            cells[GetCellIndex(level, glm::ivec3(x, y, z))] = GetCellBlock(level, glm::ivec3(x, y, z));
+          }
+        }
+      }
+
+      // Neighbours may be meshed at another level, so faces on the chunk border are culled against their
+      // blocks instead of their cells: only hidden if every block touching the face hides it
+      const auto isHiddenByNeighbors = [&](const glm::ivec3 &cell, const glm::ivec3 &normal) {
+        for (int x = 0; x < size; ++x) {
+          for (int z = 0; z < size; ++z) {
+            for (int y = 0; y < size; ++y) {
+              const glm::ivec3 neighbor = cell * size + glm::ivec3(x, y, z) + normal;
+
+              if (neighbor.x >= 0 && neighbor.x < CHUNK_WIDTH && neighbor.z >= 0 && neighbor.z < CHUNK_LENGTH) {
+                continue;
+              }
+
+              if (!HidesOpaqueFace(GetBlockUnbounded(neighbor))) {
+                return false;
+              }
+            }
+          }
+        }
+
+        return true;
+      };
+
+      for (int x = 0; x < cellCount.x; ++x) {
+        for (int z = 0; z < cellCount.z; ++z) {
+          for (int y = m_minHeight / size; y <= m_maxHeight / size; ++y) {
+            const glm::ivec3 cell(x, y, z);
+            const BlockType block = cells[GetCellIndex(level, cell)];
+
+            if (block == BlockType::Air) continue;
+
+            for (int i = Geometry::Face::First; i != Geometry::Face::Last; ++i) {
+              const auto face = static_cast<Geometry::Face>(i);
+              const glm::ivec3 normal(Geometry::GetNormal(face));
+              const glm::ivec3 next = cell + normal;
+
+              bool isVisible = true;
+              if (next.y >= 0 && next.y < cellCount.y) {
+                isVisible = next.x >= 0 && next.x < cellCount.x && next.z >= 0 && next.z < cellCount.z
+                  ? cells[GetCellIndex(level, next)] == BlockType::Air
+                  : !isHiddenByNeighbors(cell, normal);
+              }
+
+              if (isVisible) {
+                AppendOpaqueFaceGeometry(block, face, glm::vec3(cell * size), static_cast<float>(size), indexOffset, mesh.vertices, mesh.indices);
+              }
+            }
+          }
+        }
+      }
+
+      AppendLodSkirts(level, cells, indexOffset, mesh);
+    }
+
+    void Chunk::AppendLodSkirts(int level, const std::vector<BlockType> &cells, GLuint &indexOffset, ChunkMesh &mesh) {
+      const int size = 1 << level;
+
+      constexpr std::array<Geometry::Face, 4> borders = {
+        Geometry::Face::East, Geometry::Face::West, Geometry::Face::North, Geometry::Face::South
+      };
+
+      // A neighbour skips its face wherever a block of this chunk hides it. If the cell holding that block
+      // is empty at this level, the neighbour's face is drawn here instead so the seam stays closed.
+      for (const Geometry::Face border : borders) {
+        const glm::ivec3 normal(Geometry::GetNormal(border));
+        const int length = normal.x != 0 ? CHUNK_LENGTH : CHUNK_WIDTH;
+
+        for (int i = 0; i < length; ++i) {
+          for (int y = m_minHeight; y <= m_maxHeight; ++y) {
+            const glm::ivec3 pos = normal.x != 0
+              ? glm::ivec3(normal.x > 0 ? CHUNK_WIDTH - 1 : 0, y, i)
+              : glm::ivec3(i, y, normal.z > 0 ? CHUNK_LENGTH - 1 : 0);
+
+            if (!HidesOpaqueFace(GetBlockAt(pos)) || cells[GetCellIndex(level, pos / size)] != BlockType::Air) {
+              continue;
+            }
+
+            const BlockType neighbor = GetBlockUnbounded(pos + normal);
+            if (IsCellOpaque(neighbor)) {
+              AppendOpaqueFaceGeometry(neighbor, Geometry::GetOppositeFace(border), glm::vec3(pos + normal), 1.0f, indexOffset, mesh.vertices, mesh.indices);
+            }
+          }
+        }
+      }
+    }
+
+    void Chunk::SetTranslucentGeometry(std::shared_ptr<TranslucentGeometry> geometry) {
+      m_translucentGeometry = std::move(geometry);
+      BufferTranslucentVertices();
+    }
+
+    void Chunk::BufferTranslucentVertices() {
+      if (m_translucentGeometry) {
+        GetTranslucentMesh().Update(m_translucentGeometry->vertices, m_translucentGeometry->indices);
+      }
+    }
+
+    auto Chunk::GetTranslucentMesh() -> Geometry::Mesh & {
+      if (!m_translucentMesh) {
+        m_translucentMesh = std::make_unique<Geometry::Mesh>();
+      }
+      return *m_translucentMesh;
+    }
+
+    auto Chunk::HashBlocks() const -> uint64_t {
+      // FNV-1a over block ids, independent of the size of BlockType
+      uint64_t hash = 14695981039346656037ull;
+
+      for (const BlockType block : m_data.blocks) {
+        hash ^= static_cast<uint8_t>(block);
+        hash *= 1099511628211ull;
+      }
+
+      return hash;
+    }
+
+    auto Chunk::BuildTranslucentGeometry(const glm::vec3 &playerPos) -> std::shared_ptr<TranslucentGeometry> {
+      PROFILE_FUNCTION(Chunk)
+
+      auto geometry = std::make_shared<TranslucentGeometry>();
+
+      for (int x = 0; x < CHUNK_WIDTH; ++x) {
+        for (int z = 0; z < CHUNK_LENGTH; ++z) {
+          for (int y = 0; y < CHUNK_HEIGHT; ++y) {
 
             const glm::vec3 pos = glm::vec3(x, y, z);
             const BlockType block = GetBlockAt(pos);
@@ -99,59 +438,104 @@ namespace TinyMinecraft {
 
             const BlockRenderType renderType = BlockData::Get(block).renderType;
             if (renderType == BlockRenderType::Standard) {
-              AppendTranslucentBlockGeometry(block, pos, m_data.translucentFaces);
+              AppendTranslucentBlockGeometry(block, pos, playerPos, geometry->faces);
             } else if (renderType == BlockRenderType::Fluid) {
-              AppendTranslucentFluidGeometry(block, pos, m_data.translucentFaces);
+              AppendTranslucentFluidGeometry(block, pos, playerPos, geometry->faces);
             }
 
           }
         }
       }
-      
-      SortTranslucentBlocks(playerPos);
+
+      geometry->TrackMemory();
+      geometry->Sort(playerPos);
+      return geometry;
     }
 
     void Chunk::SortTranslucentBlocks(const glm::vec3 &playerPos) {
-      if (!HasTranslucentBlocks()) {
-        return;
+      if (m_translucentGeometry) {
+        m_translucentGeometry->Sort(playerPos);
       }
+    }
 
-      std::ranges::sort(m_data.translucentFaces, [playerPos](const FaceGeometry &a, const FaceGeometry &b) {
+    void TranslucentGeometry::Sort(const glm::vec3 &playerPos) {
+      std::ranges::sort(faces, [playerPos](const FaceGeometry &a, const FaceGeometry &b) {
         float distanceA = glm::distance(playerPos, a.pos);
         float distanceB = glm::distance(playerPos, b.pos);
 
         return distanceA > distanceB;
       });
 
+      vertices.clear();
+      indices.clear();
+
       GLuint indexOffset = 0;
 
-      for (const auto &faceGeom : m_data.translucentFaces) {
-        m_translucentVertices.insert(m_translucentVertices.end(), faceGeom.vertices.begin(), faceGeom.vertices.end());
+      for (const auto &faceGeom : faces) {
+        vertices.insert(vertices.end(), faceGeom.vertices.begin(), faceGeom.vertices.end());
 
         for (GLuint index : faceGeom.indices) {
-          m_translucentIndices.push_back(index + indexOffset);
+          indices.push_back(index + indexOffset);
         }
 
         indexOffset += 4;
       }
     }
 
+    void TranslucentGeometry::TrackMemory() {
+      size_t bytes = faces.capacity() * sizeof(FaceGeometry);
+      for (const FaceGeometry &face : faces) {
+        bytes += face.vertices.capacity() * sizeof(Geometry::MeshVertex) + face.indices.capacity() * sizeof(GLuint);
+      }
+
+      m_trackedBytes = static_cast<int64_t>(bytes);
+      Utils::MemoryTracker::Add(Utils::MemoryCategory::MeshStaging, m_trackedBytes);
+    }
+
     void Chunk::ClearBuffers() {
       if (ShouldClear()) {
-        m_opaqueMesh->ClearBuffers();
-        m_translucentMesh->ClearBuffers();
+        if (m_translucentMesh) m_translucentMesh->ClearBuffers();
+        m_translucentGeometry.reset();
         SetShouldClear(false);
       }
     }
 
-    auto Chunk::GetSurfaceHeight(int x, int z) -> int {
-      for (int y = CHUNK_HEIGHT - 1; y >= 0; --y) {
-        if (GetBlockAt(x, y, z) != BlockType::Air) {
-          return y;
+    void Chunk::PostFeatureBatch(std::unique_ptr<FeatureBatch> batch) {
+      const glm::ivec2 offset = batch->source - m_chunkPos;
+      if (std::abs(offset.x) > 1 || std::abs(offset.y) > 1) {
+        Utils::Logger::Error("Chunk {} was posted features by {}, which is not a neighbor.", m_chunkPos, batch->source);
+        exit(1);
+      }
+
+      // a neighbour regenerated while this chunk stays loaded posts again; only its latest batch is kept
+      delete m_featureInbox[FeatureBatchIndex(offset.x, offset.y)].exchange(batch.release(), std::memory_order_acq_rel);
+    }
+
+    void Chunk::ApplyFeatureBatches() {
+      PROFILE_FUNCTION(Chunk)
+
+      for (size_t i = 0; i < m_featureInbox.size(); ++i) {
+        if (FeatureBatch *batch = m_featureInbox[i].exchange(nullptr, std::memory_order_acquire)) {
+          m_featureBatches[i].reset(batch);
         }
       }
 
-      return 0;
+      // posting order depends on worker timing, so overlapping features are resolved in source order instead:
+      // by x, then by z
+      for (int offsetX = -1; offsetX <= 1; ++offsetX) {
+        for (int offsetZ = -1; offsetZ <= 1; ++offsetZ) {
+          const std::unique_ptr<FeatureBatch> &batch = m_featureBatches[FeatureBatchIndex(offsetX, offsetZ)];
+          if (!batch) {
+            continue;
+          }
+
+          for (const FeatureBlock &feature : batch->blocks) {
+            if (GetBlockAt(feature.x, feature.y, feature.z) == BlockType::Air) {
+              SetBlockAt(feature.x, feature.y, feature.z, feature.block);
+            }
+          }
+        }
+      }
     }
 
     auto Chunk::GetBlockUnbounded(const glm::ivec3 &pos) -> BlockType {
@@ -204,37 +588,42 @@ namespace TinyMinecraft {
         auto face = static_cast<Geometry::Face>(i);
         if (!IsFaceVisible(block, face, pos)) continue;
 
-        const std::array<glm::vec3, 4> faceVertices = Geometry::GetVertices(face);
-        const glm::vec2 topLeftTexCoord = BlockAtlas::GetNormalizedTextureCoords(block, face);
-        const glm::vec3 normal = GetNormal(face);
-        const glm::vec4 blockColor { 0.0f };
+        AppendOpaqueFaceGeometry(block, face, pos, 1.0f, indexOffset, vertices, indices);
+      }
+    }
 
-        const std::array<glm::vec2, 4> faceTexCoords = {
-          topLeftTexCoord,                                                                              // Top-left
-          { topLeftTexCoord.x, topLeftTexCoord.y + BlockAtlas::tileSize.y },                            // Bottom-left
-          { topLeftTexCoord.x + BlockAtlas::tileSize.x, topLeftTexCoord.y + BlockAtlas::tileSize.y },   // Bottom-right
-          { topLeftTexCoord.x + BlockAtlas::tileSize.x, topLeftTexCoord.y }                             // Top-right
-        };
+    void Chunk::AppendOpaqueFaceGeometry(BlockType block, Geometry::Face face, glm::vec3 pos, float size, GLuint &indexOffset, std::vector<Geometry::MeshVertex> &vertices, std::vector<GLuint> &indices) {
+      const std::array<glm::vec3, 4> faceVertices = Geometry::GetVertices(face);
+      const glm::vec2 topLeftTexCoord = BlockAtlas::GetNormalizedTextureCoords(block, face);
+      const glm::vec3 normal = GetNormal(face);
+      const glm::vec4 blockColor { 0.0f };
 
-        // push verts and indices
+      const std::array<glm::vec2, 4> faceTexCoords = {
+        topLeftTexCoord,                                                                              // Top-left
+        { topLeftTexCoord.x, topLeftTexCoord.y + BlockAtlas::tileSize.y },                            // Bottom-left
+        { topLeftTexCoord.x + BlockAtlas::tileSize.x, topLeftTexCoord.y + BlockAtlas::tileSize.y },   // Bottom-right
+        { topLeftTexCoord.x + BlockAtlas::tileSize.x, topLeftTexCoord.y }                             // Top-right
+      };
 
-        for (int i = 0; i < 4; ++i) {
-          vertices.insert(m_opaqueVertices.end(), {
-            pos + faceVertices.at(i),
-            blockColor,
-            faceTexCoords[i],
-            normal
-          });
-        }
+      // push verts and indices
 
-        indices.insert(m_opaqueIndices.end(), {
-          indexOffset + 0, indexOffset + 1, indexOffset + 2,
-          indexOffset + 2, indexOffset + 3, indexOffset + 0,
+      for (int i = 0; i < 4; ++i) {
+        vertices.insert(vertices.end(), {
+          pos + faceVertices.at(i) * size,
+          blockColor,
+          faceTexCoords[i],
+          normal
         });
-        indexOffset += 4;
       }
+
+      indices.insert(indices.end(), {
+        indexOffset + 0, indexOffset + 1, indexOffset + 2,
+        indexOffset + 2, indexOffset + 3, indexOffset + 0,
+      });
+      indexOffset += 4;
     }
-    void Chunk::AppendTranslucentBlockGeometry(BlockType block, glm::vec3 pos, std::vector<FaceGeometry> &translucentFaces) {
+
+    void Chunk::AppendTranslucentBlockGeometry(BlockType block, glm::vec3 pos, const glm::vec3 &playerPos, std::vector<FaceGeometry> &translucentFaces) {
       const glm::vec3 blockPos = GetGlobalCoords(pos);
 
       for (int i = Geometry::Face::First; i != Geometry::Face::Last; ++i) {
@@ -275,7 +664,7 @@ namespace TinyMinecraft {
           2, 3, 0,
         });
 
-        faceGeom.distanceToPlayer = glm::distance(m_world.GetPlayerPosition(), faceGeom.pos);
+        faceGeom.distanceToPlayer = glm::distance(playerPos, faceGeom.pos);
 
         translucentFaces.push_back(faceGeom);
       }
@@ -322,7 +711,7 @@ namespace TinyMinecraft {
       }
     }
 
-    void Chunk::AppendTranslucentFluidGeometry(BlockType block, glm::vec3 pos, std::vector<FaceGeometry> &translucentFaces) {
+    void Chunk::AppendTranslucentFluidGeometry(BlockType block, glm::vec3 pos, const glm::vec3 &playerPos, std::vector<FaceGeometry> &translucentFaces) {
       const glm::vec3 blockPos = GetGlobalCoords(pos);
 
       for (int i = Geometry::Face::First; i != Geometry::Face::Last; ++i) {
@@ -363,7 +752,7 @@ namespace TinyMinecraft {
           2, 3, 0,
         });
 
-        faceGeom.distanceToPlayer = glm::distance(m_world.GetPlayerPosition(), faceGeom.pos);
+        faceGeom.distanceToPlayer = glm::distance(playerPos, faceGeom.pos);
 
         translucentFaces.push_back(faceGeom);
       }
@@ -0,0 +1,160 @@
+#include "World/ChunkLifecycle.h"
+
+#include "Utils/LatencyHistogram.h"
+#include "Utils/Logger.h"
+#include "World/Chunk.h"
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+
+namespace TinyMinecraft {
+
+  namespace World {
+
+    static struct ChunkLifecycleData {
+      std::mutex mutex;
+
+      std::array<Utils::LatencyHistogram, CHUNK_STAGE_COUNT> waitTimes, runTimes;
+      std::array<long long, CHUNK_STAGE_COUNT> totalRunTimes {};
+
+      Utils::LatencyHistogram requestToDraw;
+
+      uint64_t undrawnUnloadCount = 0;
+      long long undrawnWork = 0;
+    } s_data;
+
+    auto ChunkLifecycle::GetStage(ChunkState state) -> std::optional<ChunkStage> {
+      switch (state) {
+        case ChunkState::Generating:
+          return ChunkStage::Generate;
+        case ChunkState::Decorating:
+          return ChunkStage::Decorate;
+        case ChunkState::Finalizing:
+          return ChunkStage::Finalize;
+        case ChunkState::Meshing:
+          return ChunkStage::Mesh;
+        case ChunkState::Unloading:
+          return ChunkStage::Unload;
+        default:
+          return std::nullopt;
+      }
+    }
+
+    auto ChunkLifecycle::GetStageName(ChunkStage stage) -> const char * {
+      switch (stage) {
+        case ChunkStage::Generate:
+          return "Generate";
+        case ChunkStage::Decorate:
+          return "Decorate";
+        case ChunkStage::Finalize:
+          return "Finalize";
+        case ChunkStage::Mesh:
+          return "Mesh";
+        case ChunkStage::Unload:
+        default:
+          return "Unload";
+      }
+    }
+
+    void ChunkLifecycle::RecordStage(ChunkStage stage, uint64_t queuedAt, uint64_t startedAt, uint64_t finishedAt) {
+      // a stage left without its task running, which the pipeline does not do, has nothing to measure
+      if (startedAt < queuedAt || finishedAt < startedAt) {
+        return;
+      }
+
+      const auto index = static_cast<size_t>(stage);
+
+      std::lock_guard<std::mutex> lock(s_data.mutex);
+      s_data.waitTimes[index].Record(startedAt - queuedAt);
+      s_data.runTimes[index].Record(finishedAt - startedAt);
+      s_data.totalRunTimes[index] += static_cast<long long>(finishedAt - startedAt);
+    }
+
+    void ChunkLifecycle::RecordFirstDraw(uint64_t requestedAt, uint64_t drawnAt) {
+      std::lock_guard<std::mutex> lock(s_data.mutex);
+      s_data.requestToDraw.Record(drawnAt - requestedAt);
+    }
+
+    void ChunkLifecycle::RecordUndrawnUnload(uint64_t workTime) {
+      std::lock_guard<std::mutex> lock(s_data.mutex);
+      ++s_data.undrawnUnloadCount;
+      s_data.undrawnWork += static_cast<long long>(workTime);
+    }
+
+    auto ChunkLifecycle::Snapshot(bool reset) -> ChunkLifecycleStats {
+      std::lock_guard<std::mutex> lock(s_data.mutex);
+
+      ChunkLifecycleStats stats;
+
+      for (size_t i = 0; i < CHUNK_STAGE_COUNT; ++i) {
+        const Utils::LatencyHistogram &wait = s_data.waitTimes[i];
+        const Utils::LatencyHistogram &run = s_data.runTimes[i];
+
+        stats.stages[i] = ChunkStageStats{
+          run.GetCount(),
+          static_cast<long long>(wait.GetPercentile(50.0)),
+          static_cast<long long>(wait.GetPercentile(99.0)),
+          static_cast<long long>(run.GetPercentile(50.0)),
+          static_cast<long long>(run.GetPercentile(99.0)),
+          s_data.totalRunTimes[i],
+        };
+      }
+
+      stats.drawnCount = s_data.requestToDraw.GetCount();
+      stats.requestToDrawP50 = static_cast<long long>(s_data.requestToDraw.GetPercentile(50.0));
+      stats.requestToDrawP90 = static_cast<long long>(s_data.requestToDraw.GetPercentile(90.0));
+      stats.requestToDrawP99 = static_cast<long long>(s_data.requestToDraw.GetPercentile(99.0));
+      stats.requestToDrawMax = static_cast<long long>(s_data.requestToDraw.GetMax());
+      stats.undrawnUnloadCount = s_data.undrawnUnloadCount;
+      stats.undrawnWork = s_data.undrawnWork;
+
+      if (reset) {
+        for (size_t i = 0; i < CHUNK_STAGE_COUNT; ++i) {
+          s_data.waitTimes[i].Reset();
+          s_data.runTimes[i].Reset();
+          s_data.totalRunTimes[i] = 0;
+        }
+
+        s_data.requestToDraw.Reset();
+        s_data.undrawnUnloadCount = 0;
+        s_data.undrawnWork = 0;
+      }
+
+      return stats;
+    }
+
+    void ChunkLifecycle::LogSummary(bool reset) {
+      const ChunkLifecycleStats stats = Snapshot(reset);
+      const auto ms = [](long long nanoseconds) { return static_cast<double>(nanoseconds) / 1e6; };
+
+      std::ostringstream oss;
+      oss << std::fixed << std::setprecision(3);
+      oss << "\n\n------ Chunk Lifecycle ------\n";
+
+      for (size_t i = 0; i < CHUNK_STAGE_COUNT; ++i) {
+        const ChunkStageStats &stage = stats.stages[i];
+
+        oss << std::setw(10) << std::left << GetStageName(static_cast<ChunkStage>(i))
+            << " | Runs: " << std::setw(8) << stage.count
+            << " | Wait p50: " << std::setw(8) << ms(stage.waitP50) << " ms"
+            << " | Wait p99: " << std::setw(8) << ms(stage.waitP99) << " ms"
+            << " | Run p50: " << std::setw(8) << ms(stage.runP50) << " ms"
+            << " | Run p99: " << std::setw(8) << ms(stage.runP99) << " ms"
+            << " | Total Run: " << ms(stage.totalRun) << " ms\n";
+      }
+
+      oss << "\nRequest to first draw: " << stats.drawnCount << " chunks"
+          << " | p50: " << ms(stats.requestToDrawP50) << " ms"
+          << " | p90: " << ms(stats.requestToDrawP90) << " ms"
+          << " | p99: " << ms(stats.requestToDrawP99) << " ms"
+          << " | Max: " << ms(stats.requestToDrawMax) << " ms\n";
+
+      oss << "Unloaded before drawn: " << stats.undrawnUnloadCount << " chunks, "
+          << ms(stats.undrawnWork) << " ms of worker time\n";
+
+      Utils::Logger::Log(Utils::Logger::Level::Profile, oss.str());
+    }
+
+  }
+
+}
@@ -0,0 +1,292 @@
+#include "World/FarTerrain.h"
+
+#include "Utils/Logger.h"
+#include "Utils/Profiler.h"
+#include "World/BlockAtlas.h"
+#include "World/WorldGeneration.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <utility>
+
+namespace TinyMinecraft {
+
+  namespace World {
+
+    namespace {
+
+      struct CacheHeader {
+        uint32_t magic;
+        uint32_t version;
+        int32_t samples;
+      };
+
+      constexpr uint32_t CACHE_MAGIC = 0x4e525446; // "FTRN"
+      constexpr size_t SAMPLE_COUNT = FarTerrain::SAMPLES * FarTerrain::SAMPLES;
+
+      // a tile edge: first grid vertex, step to the next one and whether its skirt faces +x or +z
+      struct TileEdge {
+        GLuint first, step;
+        bool isFlipped;
+      };
+
+      constexpr std::array<TileEdge, 4> tileEdges = {
+        TileEdge{ 0, 1, false },                                                  // -z
+        TileEdge{ FarTerrain::RESOLUTION * FarTerrain::SAMPLES, 1, true },        // +z
+        TileEdge{ 0, FarTerrain::SAMPLES, true },                                 // -x
+        TileEdge{ FarTerrain::RESOLUTION, FarTerrain::SAMPLES, false },           // +x
+      };
+
+    }
+
+    FarTerrain::FarTerrain(const WorldGeneration &generation, int seed)
+      : m_generation(generation)
+      , m_cacheDirectory(std::filesystem::path("../cache/far_terrain") / std::to_string(seed))
+    {}
+
+    auto FarTerrain::Update(const glm::ivec2 &playerChunkPos) -> bool {
+      if (m_hasSelection && playerChunkPos == m_playerChunkPos) {
+        return false;
+      }
+
+      PROFILE_FUNCTION(Chunk)
+
+      m_playerChunkPos = playerChunkPos;
+      m_hasSelection = true;
+      m_selection.clear();
+
+      const int rootChunks = GetTileChunks(LEVEL_COUNT - 1);
+      const auto rootPos = [rootChunks](int chunk) { return static_cast<int>(std::floor(static_cast<float>(chunk) / rootChunks)); };
+      const glm::ivec2 first(rootPos(playerChunkPos.x - GFX_FAR_DISTANCE), rootPos(playerChunkPos.y - GFX_FAR_DISTANCE));
+      const glm::ivec2 last(rootPos(playerChunkPos.x + GFX_FAR_DISTANCE), rootPos(playerChunkPos.y + GFX_FAR_DISTANCE));
+
+      for (int z = first.y; z <= last.y; ++z) {
+        for (int x = first.x; x <= last.x; ++x) {
+          Select(FarTileKey{ glm::ivec2(x, z), LEVEL_COUNT - 1 });
+        }
+      }
+
+      m_selected = KeySet(m_selection.begin(), m_selection.end());
+      std::erase_if(m_requested, [this](const FarTileKey &key) { return !m_selected.contains(key); });
+
+      for (const FarTileKey &key : m_selection) {
+        if (m_requested.insert(key).second) {
+          m_requests.push_back(key);
+        }
+      }
+
+      ++m_selectionVersion;
+      return true;
+    }
+
+    void FarTerrain::Select(const FarTileKey &key) {
+      const auto size = static_cast<float>(GetTileChunks(key.level));
+      const glm::vec2 min = glm::vec2(key.pos) * size;
+      const glm::vec2 max = min + size;
+      const glm::vec2 center = glm::vec2(m_playerChunkPos) + 0.5f;
+
+      const float nearest = glm::distance(center, glm::clamp(center, min, max));
+      const float farthest = glm::length(glm::max(glm::abs(center - min), glm::abs(center - max)));
+
+      // beyond the horizon or entirely covered by chunks
+      if (nearest > GFX_FAR_DISTANCE || farthest < GFX_RENDER_DISTANCE - 1) {
+        return;
+      }
+
+      if (key.level > 0 && nearest < SPLIT_DISTANCE * size) {
+        for (int z = 0; z < 2; ++z) {
+          for (int x = 0; x < 2; ++x) {
+            Select(FarTileKey{ key.pos * 2 + glm::ivec2(x, z), key.level - 1 });
+          }
+        }
+        return;
+      }
+
+      m_selection.push_back(key);
+    }
+
+    auto FarTerrain::TakeRequests() -> std::vector<FarTileKey> {
+      // finest first, they are the closest
+      std::ranges::sort(m_requests, {}, &FarTileKey::level);
+      return std::exchange(m_requests, {});
+    }
+
+    void FarTerrain::Build(const FarTileKey &key) {
+      PROFILE_FUNCTION(Chunk)
+
+      const int spacing = GetTileChunks(key.level) * CHUNK_WIDTH / RESOLUTION;
+      const glm::ivec2 origin = key.pos * GetTileChunks(key.level) * CHUNK_WIDTH;
+
+      std::vector<int16_t> heights;
+      std::vector<BlockType> blocks;
+
+      if (!ReadCache(key, heights, blocks)) {
+        m_generation.GenerateHeightmap(origin, spacing, SAMPLES, heights, blocks);
+        WriteCache(key, heights, blocks);
+      }
+
+      auto tile = std::make_shared<FarTile>();
+      tile->key = key;
+      BuildVertices(*tile, origin, spacing, heights, blocks);
+
+      m_builtTiles.push(std::move(tile));
+    }
+
+    void FarTerrain::BuildVertices(FarTile &tile, const glm::ivec2 &origin, int spacing, const std::vector<int16_t> &heights, const std::vector<BlockType> &blocks) {
+      // deep enough to cover the difference to a neighbor sampled twice as coarsely on most slopes
+      const float skirtDepth = 2.0f * spacing;
+
+      const auto getHeight = [&](int x, int z) { return static_cast<float>(heights[z * SAMPLES + x] + 1); };
+
+      tile.vertices.reserve(TILE_VERTEX_COUNT);
+      tile.min = glm::vec3(origin.x, CHUNK_HEIGHT, origin.y);
+      tile.max = glm::vec3(origin.x + RESOLUTION * spacing, 0.0f, origin.y + RESOLUTION * spacing);
+
+      for (int z = 0; z < SAMPLES; ++z) {
+        for (int x = 0; x < SAMPLES; ++x) {
+          const int x0 = std::max(x - 1, 0), x1 = std::min(x + 1, RESOLUTION);
+          const int z0 = std::max(z - 1, 0), z1 = std::min(z + 1, RESOLUTION);
+          const float slopeX = (getHeight(x1, z) - getHeight(x0, z)) / static_cast<float>((x1 - x0) * spacing);
+          const float slopeZ = (getHeight(x, z1) - getHeight(x, z0)) / static_cast<float>((z1 - z0) * spacing);
+
+          const float height = getHeight(x, z);
+          const BlockType block = blocks[z * SAMPLES + x];
+
+          tile.vertices.push_back(Geometry::MeshVertex{
+            glm::vec3(origin.x + x * spacing, height, origin.y + z * spacing),
+            glm::vec4(0.0f),
+            BlockAtlas::GetNormalizedTextureCoords(block, Geometry::Face::Top) + 0.5f * BlockAtlas::tileSize,
+            glm::normalize(glm::vec3(-slopeX, 1.0f, -slopeZ))
+          });
+
+          tile.min.y = std::min(tile.min.y, height - skirtDepth);
+          tile.max.y = std::max(tile.max.y, height);
+        }
+      }
+
+      for (const TileEdge &edge : tileEdges) {
+        for (GLuint i = 0; i < SAMPLES; ++i) {
+          Geometry::MeshVertex vertex = tile.vertices[edge.first + i * edge.step];
+          vertex.position.y -= skirtDepth;
+          tile.vertices.push_back(vertex);
+        }
+      }
+    }
+
+    auto FarTerrain::GetTileIndices() -> const std::vector<GLuint> & {
+      static const std::vector<GLuint> indices = []() {
+        std::vector<GLuint> result;
+        result.reserve(TILE_INDEX_COUNT);
+
+        // counter-clockwise seen from above
+        for (GLuint z = 0; z < RESOLUTION; ++z) {
+          for (GLuint x = 0; x < RESOLUTION; ++x) {
+            const GLuint i = z * SAMPLES + x;
+            result.insert(result.end(), { i, i + SAMPLES, i + 1, i + 1, i + SAMPLES, i + SAMPLES + 1 });
+          }
+        }
+
+        // counter-clockwise seen from outside the tile
+        GLuint skirt = SAMPLES * SAMPLES;
+        for (const TileEdge &edge : tileEdges) {
+          for (GLuint i = 0; i < RESOLUTION; ++i) {
+            const GLuint top0 = edge.first + i * edge.step, top1 = top0 + edge.step;
+            const GLuint bottom0 = skirt + i, bottom1 = bottom0 + 1;
+
+            if (edge.isFlipped) {
+              result.insert(result.end(), { top0, bottom0, top1, top1, bottom0, bottom1 });
+            } else {
+              result.insert(result.end(), { top0, top1, bottom0, top1, bottom1, bottom0 });
+            }
+          }
+          skirt += SAMPLES;
+        }
+
+        return result;
+      }();
+
+      return indices;
+    }
+
+    auto FarTerrain::GetCachePath(const FarTileKey &key) const -> std::filesystem::path {
+      return m_cacheDirectory / (std::to_string(key.level) + "_" + std::to_string(key.pos.x) + "_" + std::to_string(key.pos.y) + ".bin");
+    }
+
+    auto FarTerrain::ReadCache(const FarTileKey &key, std::vector<int16_t> &heights, std::vector<BlockType> &blocks) const -> bool {
+      if (!m_isCacheEnabled) {
+        return false;
+      }
+
+      std::ifstream file(GetCachePath(key), std::ios::binary);
+      if (!file.is_open()) {
+        return false;
+      }
+
+      CacheHeader header {};
+      file.read(reinterpret_cast<char *>(&header), sizeof(header));
+
+      if (!file || header.magic != CACHE_MAGIC || header.version != CACHE_VERSION || header.samples != SAMPLES) {
+        return false;
+      }
+
+      std::vector<uint8_t> blockIds(SAMPLE_COUNT);
+      heights.resize(SAMPLE_COUNT);
+      file.read(reinterpret_cast<char *>(heights.data()), static_cast<std::streamsize>(SAMPLE_COUNT * sizeof(int16_t)));
+      file.read(reinterpret_cast<char *>(blockIds.data()), static_cast<std::streamsize>(SAMPLE_COUNT));
+
+      if (!file) {
+        return false;
+      }
+
+      blocks.resize(SAMPLE_COUNT);
+      std::ranges::transform(blockIds, blocks.begin(), [](uint8_t id) { return static_cast<BlockType>(id); });
+      return true;
+    }
+
+    void FarTerrain::WriteCache(const FarTileKey &key, const std::vector<int16_t> &heights, const std::vector<BlockType> &blocks) const {
+      std::call_once(m_cacheDirectoryCreated, [this] {
+        std::error_code error;
+        std::filesystem::create_directories(m_cacheDirectory, error);
+
+        if (error) {
+          Utils::Logger::Warning("Far terrain: cannot create cache directory {}, tiles will not be cached.", m_cacheDirectory.string());
+          m_isCacheEnabled = false;
+        }
+      });
+
+      if (!m_isCacheEnabled) {
+        return;
+      }
+
+      std::vector<uint8_t> blockIds(SAMPLE_COUNT);
+      std::ranges::transform(blocks, blockIds.begin(), [](BlockType block) { return static_cast<uint8_t>(block); });
+
+      // written aside and renamed, so an interrupted write never leaves a tile that reads back wrong
+      const std::filesystem::path path = GetCachePath(key);
+      std::filesystem::path temporaryPath = path;
+      temporaryPath += ".tmp";
+
+      {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        const CacheHeader header { CACHE_MAGIC, CACHE_VERSION, SAMPLES };
+
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char *>(heights.data()), static_cast<std::streamsize>(SAMPLE_COUNT * sizeof(int16_t)));
+        file.write(reinterpret_cast<const char *>(blockIds.data()), static_cast<std::streamsize>(SAMPLE_COUNT));
+
+        if (!file) {
+          Utils::Logger::Warning("Far terrain: cannot write {}.", temporaryPath.string());
+          return;
+        }
+      }
+
+      std::error_code error;
+      std::filesystem::rename(temporaryPath, path, error);
+    }
+
+  }
+
+}
@@ -0,0 +1,126 @@
+#include "World/SectionVisibility.h"
+
+#include "Utils/Profiler.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace TinyMinecraft {
+
+  namespace World {
+
+    void SectionVisibility::Compute(const std::vector<Chunk *> &chunks, const std::vector<ChunkVisibility> &visibility, const glm::vec3 &cameraPos, const Geometry::Frustum &frustum) {
+      PROFILE_FUNCTION(Graphics)
+
+      // in Geometry::Face order, so the opposite face of `face` is `face ^ 1`
+      constexpr std::array<glm::ivec3, 6> faceOffsets = {
+        glm::ivec3(0, 1, 0), glm::ivec3(0, -1, 0), glm::ivec3(1, 0, 0), glm::ivec3(-1, 0, 0), glm::ivec3(0, 0, 1), glm::ivec3(0, 0, -1)
+      };
+
+      m_queue.clear();
+      m_sectionStates.assign(chunks.size() * CHUNK_SECTION_COUNT, SectionState::Unvisited);
+      m_chunkVisible.assign(chunks.size(), false);
+      m_visibleSectionCount = 0;
+
+      glm::ivec2 gridMax { 0 };
+      m_gridMin = glm::ivec2(0);
+      for (size_t i = 0; i < chunks.size(); ++i) {
+        const glm::ivec2 chunkPos = chunks[i]->GetChunkPos();
+        m_gridMin = i == 0 ? chunkPos : glm::min(m_gridMin, chunkPos);
+        gridMax = i == 0 ? chunkPos : glm::max(gridMax, chunkPos);
+      }
+
+      m_gridSize = chunks.empty() ? glm::ivec2(0) : gridMax - m_gridMin + 1;
+      m_chunkGrid.assign(static_cast<size_t>(m_gridSize.x) * m_gridSize.y, -1);
+      for (size_t i = 0; i < chunks.size(); ++i) {
+        const glm::ivec2 cell = chunks[i]->GetChunkPos() - m_gridMin;
+        m_chunkGrid[cell.y * m_gridSize.x + cell.x] = static_cast<int32_t>(i);
+      }
+
+      const glm::ivec3 start(
+        static_cast<int>(std::floor(cameraPos.x / CHUNK_WIDTH)),
+        static_cast<int>(std::floor(cameraPos.y / CHUNK_SECTION_HEIGHT)),
+        static_cast<int>(std::floor(cameraPos.z / CHUNK_LENGTH))
+      );
+
+      const int32_t startChunk = FindChunk(start.x, start.z);
+
+      // outside the loaded world there is nothing to walk through, so skip occlusion culling
+      if (startChunk < 0 || start.y < 0 || start.y >= CHUNK_SECTION_COUNT) {
+        MarkAllVisible();
+        return;
+      }
+
+      m_sectionStates[startChunk * CHUNK_SECTION_COUNT + start.y] = SectionState::Visible;
+      m_queue.push_back(Step{ start, static_cast<size_t>(startChunk), Geometry::Face::None, 0 });
+
+      for (size_t head = 0; head < m_queue.size(); ++head) {
+        const Step step = m_queue[head];
+
+        m_chunkVisible[step.chunkIndex] = true;
+        ++m_visibleSectionCount;
+
+        const SectionConnectivity connectivity = visibility[step.chunkIndex].connectivity[step.section.y];
+
+        for (int i = 0; i < 6; ++i) {
+          const auto face = static_cast<Geometry::Face>(i);
+          const auto opposite = static_cast<Geometry::Face>(i ^ 1);
+
+          if (step.directions & (1 << opposite)) {
+            continue;
+          }
+
+          if (step.entryFace != Geometry::Face::None && !CanSeeThrough(connectivity, step.entryFace, face)) {
+            continue;
+          }
+
+          const glm::ivec3 next = step.section + faceOffsets[i];
+          if (next.y < 0 || next.y >= CHUNK_SECTION_COUNT) {
+            continue;
+          }
+
+          size_t chunkIndex = step.chunkIndex;
+          if (next.x != step.section.x || next.z != step.section.z) {
+            const int32_t index = FindChunk(next.x, next.z);
+            if (index < 0) {
+              continue;
+            }
+            chunkIndex = index;
+          }
+
+          SectionState &state = m_sectionStates[chunkIndex * CHUNK_SECTION_COUNT + next.y];
+          if (state != SectionState::Unvisited) {
+            continue;
+          }
+
+          const glm::vec3 min(next.x * CHUNK_WIDTH, next.y * CHUNK_SECTION_HEIGHT, next.z * CHUNK_LENGTH);
+          const glm::vec3 max = min + glm::vec3(CHUNK_WIDTH, CHUNK_SECTION_HEIGHT, CHUNK_LENGTH);
+
+          if (!frustum.IsBoxVisible(min, max)) {
+            state = SectionState::Rejected;
+            continue;
+          }
+
+          state = SectionState::Visible;
+          m_queue.push_back(Step{ next, chunkIndex, opposite, static_cast<uint8_t>(step.directions | (1 << face)) });
+        }
+      }
+    }
+
+    auto SectionVisibility::FindChunk(int x, int z) const -> int32_t {
+      const glm::ivec2 cell = glm::ivec2(x, z) - m_gridMin;
+      if (cell.x < 0 || cell.y < 0 || cell.x >= m_gridSize.x || cell.y >= m_gridSize.y) {
+        return -1;
+      }
+      return m_chunkGrid[cell.y * m_gridSize.x + cell.x];
+    }
+
+    void SectionVisibility::MarkAllVisible() {
+      std::ranges::fill(m_sectionStates, SectionState::Visible);
+      std::ranges::fill(m_chunkVisible, true);
+      m_visibleSectionCount = m_sectionStates.size();
+    }
+
+  }
+
+}
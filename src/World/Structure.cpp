@@ -0,0 +1,161 @@
+#include "World/Structure.h"
+
+#include "Utils/Logger.h"
+#include "Utils/defs.h"
+#include "World/Block.h"
+#include <algorithm>
+#include <climits>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <unordered_map>
+
+namespace TinyMinecraft {
+
+  namespace World {
+
+    auto Structure::Load(const std::string &path) -> Structure {
+      std::ifstream file(path);
+
+      if (!file.is_open()) {
+        Utils::Logger::Error("Json: file cannot open");
+        exit(1);
+      }
+
+      nlohmann::json json;
+      file >> json;
+
+      if (
+        !json["name"].is_string() ||
+        !json["origin"].is_array() ||
+        !json["palette"].is_object() ||
+        !json["layers"].is_array()
+      ) {
+        Utils::Logger::Error("Invalid structure at path {}: Missing attributes.", path);
+        exit(1);
+      }
+
+      Structure structure;
+      structure.m_name = json["name"];
+
+      const glm::ivec2 origin(json["origin"][0].get<int>(), json["origin"][1].get<int>());
+
+      std::unordered_map<char, BlockType> palette;
+      for (const auto &[key, value] : json["palette"].items()) {
+        BlockType block;
+        if (key.size() != 1 || !value.is_string() || !BlockData::FromName(value, block)) {
+          Utils::Logger::Error("Invalid structure at path {}: Invalid palette entry \"{}\".", path, key);
+          exit(1);
+        }
+        palette[key[0]] = block;
+      }
+
+      structure.m_min = glm::ivec2(INT_MAX);
+      structure.m_max = glm::ivec2(INT_MIN);
+
+      // layers go bottom to top, rows go south (+z) and characters go east (+x)
+      for (const auto &rows : json["layers"]) {
+        StructureLayer layer{ {}, glm::ivec2(INT_MAX), glm::ivec2(INT_MIN) };
+
+        for (int row = 0; row < rows.size(); ++row) {
+          const std::string line = rows[row];
+
+          for (int column = 0; column < line.size();) {
+            const char symbol = line[column];
+            int length = 1;
+            while (column + length < line.size() && line[column + length] == symbol) {
+              ++length;
+            }
+
+            if (symbol != '.' && symbol != ' ') {
+              const auto it = palette.find(symbol);
+              if (it == palette.end()) {
+                Utils::Logger::Error("Invalid structure at path {}: Unknown symbol '{}'.", path, symbol);
+                exit(1);
+              }
+
+              const int x = column - origin.x;
+              const int z = row - origin.y;
+              layer.runs.push_back(StructureRun{
+                static_cast<int8_t>(x), static_cast<int8_t>(z), static_cast<uint8_t>(length), it->second
+              });
+
+              layer.min = glm::min(layer.min, glm::ivec2(x, z));
+              layer.max = glm::max(layer.max, glm::ivec2(x + length - 1, z));
+            }
+
+            column += length;
+          }
+        }
+
+        structure.m_min = glm::min(structure.m_min, layer.min);
+        structure.m_max = glm::max(structure.m_max, layer.max);
+        structure.m_layers.push_back(std::move(layer));
+      }
+
+      // stamping only routes blocks to direct neighbours
+      if (structure.m_layers.empty() || structure.GetRadius() >= std::min(CHUNK_WIDTH, CHUNK_LENGTH)) {
+        Utils::Logger::Error("Invalid structure at path {}: Structure is empty or too wide.", path);
+        exit(1);
+      }
+
+      return structure;
+    }
+
+    void Structure::Stamp(Chunk *chunk, const glm::ivec3 &anchor, FeatureBatches &outside) const {
+      for (int dy = 0; dy < GetHeight(); ++dy) {
+        const StructureLayer &layer = m_layers[dy];
+        const int y = anchor.y + dy;
+
+        if (y < 0 || y >= CHUNK_HEIGHT || layer.runs.empty()) {
+          continue;
+        }
+
+        const bool isInside = anchor.x + layer.min.x >= 0 && anchor.x + layer.max.x < CHUNK_WIDTH
+                           && anchor.z + layer.min.y >= 0 && anchor.z + layer.max.y < CHUNK_LENGTH;
+
+        if (isInside) {
+          for (const StructureRun &run : layer.runs) {
+            chunk->FillRow(anchor.x + run.x, y, anchor.z + run.z, run.length, run.block);
+          }
+          continue;
+        }
+
+        for (const StructureRun &run : layer.runs) {
+          StampRun(chunk, anchor.x + run.x, y, anchor.z + run.z, run.length, run.block, outside);
+        }
+      }
+    }
+
+    void Structure::StampRun(Chunk *chunk, int x, int y, int z, int length, BlockType block, FeatureBatches &outside) {
+      const int offsetZ = z < 0 ? -1 : (z >= CHUNK_LENGTH ? 1 : 0);
+      const int localZ = z - offsetZ * CHUNK_LENGTH;
+
+      // split the run where it crosses the west and east borders
+      for (int offsetX = -1; offsetX <= 1; ++offsetX) {
+        const int from = std::max(x, offsetX * CHUNK_WIDTH);
+        const int to = std::min(x + length, (offsetX + 1) * CHUNK_WIDTH);
+
+        if (from >= to) {
+          continue;
+        }
+
+        if (offsetX == 0 && offsetZ == 0) {
+          chunk->FillRow(from, y, localZ, to - from, block);
+          continue;
+        }
+
+        std::vector<FeatureBlock> &batch = outside[FeatureBatchIndex(offsetX, offsetZ)];
+        for (int i = from; i < to; ++i) {
+          batch.push_back(FeatureBlock{
+            static_cast<uint8_t>(i - offsetX * CHUNK_WIDTH),
+            static_cast<uint8_t>(y),
+            static_cast<uint8_t>(localZ),
+            block
+          });
+        }
+      }
+    }
+
+  }
+
+}
@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <cmath>
 #include <cstddef>
 #include <cstdlib>
@@ -9,6 +10,8 @@
 #include <tuple>
 #include <vector>
 #include "World/World.h"
+#include "Events/EventHandler.h"
+#include "Events/World/ChunkEvents.h"
 #include "Geometry/geometry.h"
 #include "Math/misc.h"
 #include "Utils/Logger.h"
@@ -26,11 +29,13 @@ namespace TinyMinecraft {
 
   namespace World {
 
-    World::World()
-      : m_worldGen(*this)
+    World::World(int seed, unsigned int workerCount)
+      : m_seed(seed)
+      , m_worldGen(*this, seed)
+      , m_farTerrain(m_worldGen, seed)
     {
       // const int NUM_THREADS = 1;
-      const int NUM_THREADS = std::thread::hardware_concurrency();
+      const int NUM_THREADS = workerCount > 0 ? workerCount : std::thread::hardware_concurrency();
 
       for (int i = 0; i < NUM_THREADS; ++i) {
         m_workers.emplace_back(&World::DoTasks, this, i);
@@ -149,8 +154,11 @@ namespace TinyMinecraft {
         glm::ivec2(0, 0), glm::ivec2(1, 0), glm::ivec2(-1, 0), glm::ivec2(0, 1), glm::ivec2(0, -1)
       };
 
+      // every generation stage waits on one more ring of neighbors: meshing needs finalized neighbors,
+      // which need decorated neighbors, which need generated terrain around them. One more ring because the
+      // diagonal neighbors of a chunk on a circle reach past the next circle
       constexpr int viewRadius = GFX_RENDER_DISTANCE;
-      constexpr int loadRadius = viewRadius + 1;
+      constexpr int loadRadius = viewRadius + 4;
 
       const glm::ivec2 playerChunkPos = GetChunkPosFromCoords(playerPos);
       std::vector<glm::ivec2> nearbyChunks;
@@ -194,25 +202,25 @@ namespace TinyMinecraft {
         const int withinLoadRadius = IsNearby(chunkPos, loadRadius);
 
         if (withinLoadRadius) {
-          if (state == ChunkState::Empty && chunk->SetState(ChunkState::Empty, ChunkState::Generating)) {
-            ScheduleGenerateTask(chunk);
+          if (AdvanceGeneration(chunk, chunkPos, state)) {
             continue;
           }
 
           // check that this chunk and all its neighbors are generated before attempting to mesh
 
           // needs to atomically assure this stuff....
-          bool neighborsGenerated = true;
-          std::ranges::for_each(neighborOffsets, [&](glm::ivec2 offset) {
-            glm::ivec2 pos = glm::ivec2(chunkPos.x + offset.x, chunkPos.y + offset.y);
-            if (!HasChunk(pos) || GetChunkAt(pos)->GetState() < ChunkState::Generated) {
-              neighborsGenerated = false;
-            }
-          });
+          const bool neighborsGenerated = AreNeighborsAtLeast(chunkPos, neighborOffsets, ChunkState::Generated);
 
           if (neighborsGenerated && chunk->SetState(ChunkState::Generated, ChunkState::Meshing)) {
             ScheduleMeshTask(chunk);
           }
+
+        #ifdef GFX_MeshLOD
+          // moved into another detail ring since it was meshed
+          if (state == ChunkState::Loaded && chunk->GetMeshLevel() != GetMeshLevel(chunkPos) && chunk->SetState(ChunkState::Loaded, ChunkState::Meshing)) {
+            ScheduleMeshTask(chunk);
+          }
+        #endif
           
           continue;
         }
@@ -220,7 +228,11 @@ namespace TinyMinecraft {
         bool shouldErase = false;
 
         if (!IsNearby(chunkPos, viewRadius)) {
-          if ((!withinLoadRadius && state == ChunkState::Generated) || state == ChunkState::Loaded) {
+          const bool isResting = state == ChunkState::TerrainGenerated || state == ChunkState::Decorated
+                              || state == ChunkState::Generated || state == ChunkState::Loaded;
+
+          // a neighbor still decorating may post into this chunk's inbox, which survives unloading
+          if (isResting) {
             // check that deleting this chunk won't prevent proper working of Meshing chunks
             bool hasNearbyIntermediateChunk = false;
             std::ranges::for_each(neighborOffsets, [&](glm::ivec2 offset) {
@@ -239,6 +251,87 @@ namespace TinyMinecraft {
           }
         }
       }
+
+    #ifdef GFX_FarTerrain
+      if (m_farTerrain.Update(playerChunkPos)) {
+        for (const FarTileKey &key : m_farTerrain.TakeRequests()) {
+          SubmitTask([this, key]() { m_farTerrain.Build(key); });
+        }
+      }
+    #endif
+
+      PROFILE_COUNTER("chunks", m_chunks.size())
+      PROFILE_COUNTER("queued tasks", m_submittedTaskCount.load() - m_finishedTaskCount.load())
+    }
+
+    void World::GenerateChunks(const std::vector<glm::ivec2> &chunkPositions) {
+      // finalizing a chunk needs decorated neighbors, which need terrain around them
+      constexpr int margin = 2;
+
+      for (const glm::ivec2 &chunkPos : chunkPositions) {
+        for (int dz = -margin; dz <= margin; ++dz) {
+          for (int dx = -margin; dx <= margin; ++dx) {
+            const glm::ivec2 pos = chunkPos + glm::ivec2(dx, dz);
+            if (!HasChunk(pos)) {
+              m_chunks[pos] = std::make_unique<Chunk>(*this, pos);
+            }
+          }
+        }
+      }
+
+      const auto isGenerated = [this](const glm::ivec2 &chunkPos) {
+        return GetChunkAt(chunkPos)->GetState() >= ChunkState::Generated;
+      };
+
+      while (!std::ranges::all_of(chunkPositions, isGenerated)) {
+        for (auto it = m_chunks.begin(); it != m_chunks.end(); ++it) {
+          AdvanceGeneration(it->second.get(), it->first, it->second->GetState());
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    }
+
+    auto World::AdvanceGeneration(Chunk *chunk, const glm::ivec2 &chunkPos, ChunkState state) -> bool {
+      // features may reach into any of the 8 surrounding chunks
+      constexpr std::array<glm::ivec2, 9> featureNeighborOffsets = {
+        glm::ivec2(-1, -1), glm::ivec2(0, -1), glm::ivec2(1, -1),
+        glm::ivec2(-1, 0),  glm::ivec2(0, 0),  glm::ivec2(1, 0),
+        glm::ivec2(-1, 1),  glm::ivec2(0, 1),  glm::ivec2(1, 1),
+      };
+
+      if (state == ChunkState::Empty && chunk->SetState(ChunkState::Empty, ChunkState::Generating)) {
+        ScheduleGenerateTask(chunk);
+        return true;
+      }
+
+      if (state == ChunkState::TerrainGenerated
+          && AreNeighborsAtLeast(chunkPos, featureNeighborOffsets, ChunkState::TerrainGenerated)
+          && chunk->SetState(ChunkState::TerrainGenerated, ChunkState::Decorating)) {
+        ScheduleDecorateTask(chunk);
+        return true;
+      }
+
+      // all neighbors must be done posting features into this chunk's inbox
+      if (state == ChunkState::Decorated
+          && AreNeighborsAtLeast(chunkPos, featureNeighborOffsets, ChunkState::Decorated)
+          && chunk->SetState(ChunkState::Decorated, ChunkState::Finalizing)) {
+        ScheduleFinalizeTask(chunk);
+        return true;
+      }
+
+      return false;
+    }
+
+    auto World::GetMeshLevel(const glm::ivec2 &chunkPos) -> int {
+    #ifdef GFX_MeshLOD
+      const glm::ivec2 offset = chunkPos - GetChunkPosFromCoords(m_playerPosition);
+      const int distanceSquared = offset.x * offset.x + offset.y * offset.y;
+
+      if (distanceSquared >= GFX_LOD_4X_DISTANCE * GFX_LOD_4X_DISTANCE) return 2;
+      if (distanceSquared >= GFX_LOD_2X_DISTANCE * GFX_LOD_2X_DISTANCE) return 1;
+    #endif
+      return 0;
     }
 
     void World::RefreshChunkAt(const glm::vec3 &pos) {
@@ -358,6 +451,7 @@ namespace TinyMinecraft {
       {
         std::unique_lock lk(m_taskMutex);
         m_tasks.push(std::move(task));
+        ++m_submittedTaskCount;
       }
 
       m_nonempty.notify_one();
@@ -377,9 +471,53 @@ namespace TinyMinecraft {
           return;
         }
 
+        chunk->BeginStageTask();
+
         m_worldGen.GenerateTerrainChunk(chunk);
 
-        chunk->SetState(ChunkState::Generating, ChunkState::Generated);
+        chunk->SetState(ChunkState::Generating, ChunkState::TerrainGenerated);
+      });
+    }
+
+    void World::ScheduleDecorateTask(Chunk *chunk) {
+      if (!chunk) {
+        Utils::Logger::Error("Cannot decorate task for null chunks");
+        exit(1);
+      }
+
+      SubmitTask([this, chunk]() {
+        const ChunkState state = chunk->GetState();
+        if (state != ChunkState::Decorating) {
+          Utils::Logger::Warning("Chunk {} had incorrect state while decorating!", chunk->GetChunkPos());
+          return;
+        }
+
+        chunk->BeginStageTask();
+
+        m_worldGen.GenerateFeatures(chunk);
+
+        chunk->SetState(ChunkState::Decorating, ChunkState::Decorated);
+      });
+    }
+
+    void World::ScheduleFinalizeTask(Chunk *chunk) {
+      if (!chunk) {
+        Utils::Logger::Error("Cannot finalize task for null chunks");
+        exit(1);
+      }
+
+      SubmitTask([this, chunk]() {
+        const ChunkState state = chunk->GetState();
+        if (state != ChunkState::Finalizing) {
+          Utils::Logger::Warning("Chunk {} had incorrect state while finalizing!", chunk->GetChunkPos());
+          return;
+        }
+
+        chunk->BeginStageTask();
+
+        chunk->ApplyFeatureBatches();
+
+        chunk->SetState(ChunkState::Finalizing, ChunkState::Generated);
       });
     }
 
@@ -390,7 +528,10 @@ namespace TinyMinecraft {
       }
 
 
-      SubmitTask([this, chunk]() {
+      const int level = GetMeshLevel(chunk->GetChunkPos());
+
+      // the worker must not read m_playerPosition, which the main thread updates
+      SubmitTask([this, chunk, level, playerPos = m_playerPosition]() {
         const ChunkState state = chunk->GetState();
 
         if (state != ChunkState::Meshing) {
@@ -398,12 +539,15 @@ namespace TinyMinecraft {
           return;
         }
 
-        chunk->UpdateMesh();
-        chunk->UpdateTranslucentMesh(m_playerPosition);
-        chunk->SetDirty(true);
-        chunk->SetTranslucentDirty(true);
+        chunk->BeginStageTask();
+
+        std::shared_ptr<const ChunkMesh> mesh = chunk->UpdateMesh(level, playerPos);
 
+        // pushed before the chunk is Loaded, so an unload of it cannot be queued ahead of its mesh
+        m_renderEvents.push(ChunkRenderEvent{ chunk, ChunkRenderEvent::Type::Meshed, std::move(mesh) });
         chunk->SetState(ChunkState::Meshing, ChunkState::Loaded);
+
+        Event::EventHandler::Post(Event::ChunkLoadedEvent(chunk->GetChunkPos(), level));
       });
     }
 
@@ -420,10 +564,13 @@ namespace TinyMinecraft {
           Utils::Logger::Warning("Chunk {} had incorrect state while unloading!", chunk->GetChunkPos());
           return;
         }
+
+        chunk->BeginStageTask();
         
         chunk->SetShouldClear(true);
         chunk->ClearBlocks();
         chunk->SetState(ChunkState::Unloading, ChunkState::Empty);
+        m_renderEvents.push(ChunkRenderEvent{ chunk, ChunkRenderEvent::Type::Unloaded, nullptr });
       });
     }
 
@@ -448,7 +595,12 @@ namespace TinyMinecraft {
           m_tasks.pop();
         }
 
-        task();
+        {
+          // each task is one stage of one chunk, so this totals the time and allocations of a chunk job
+          PROFILE_SCOPE(Chunk, "World::Task")
+          task();
+        }
+        ++m_finishedTaskCount;
       }
     }
 
@@ -5,6 +5,7 @@
 #include "FastNoise/Generators/Perlin.h"
 #include "FastNoise/Generators/Simplex.h"
 #include "Utils/Logger.h"
+#include "Utils/MemoryTracker.h"
 #include "Utils/Profiler.h"
 #include "Utils/defs.h"
 #include "Utils/mathgl.h"
@@ -12,14 +13,16 @@
 #include "World/Biome.h"
 #include "World/Block.h"
 #include "World/Chunk.h"
+#include "World/Structure.h"
 #include "World/World.h"
 #include "Math/splines.h"
+#include <algorithm>
 #include <array>
+#include <bitset>
 #include <cstddef>
 #include <fstream>
 #include <nlohmann/json.hpp>
 #include <string>
-#include <unordered_set>
 #include <utility>
 
 namespace TinyMinecraft {
@@ -28,7 +31,11 @@ namespace TinyMinecraft {
 
     // FastNoise::SmartNode<FastNoise::Perlin> WorldGeneration::s_simplex = FastNoise::New<FastNoise::Perlin>();
 
-    WorldGeneration::WorldGeneration(World &world) : m_world(world) {
+    WorldGeneration::WorldGeneration(World &world, int seed)
+      : m_world(world)
+      , m_seed(seed)
+      , m_tree(Structure::Load("../data/structures/oak_tree.json"))
+    {
       // auto m_baseTerrain = FastNoise::New<FastNoise::FractalFBm>();
       // m_baseTerrain->SetSource(terrain);
       // m_baseTerrain->SetOctaveCount(1);
@@ -73,14 +80,17 @@ namespace TinyMinecraft {
       erosionSplinePoints.reserve(erosionSplines.size());
       ridgesSplinePoints.reserve(ridgesSplines.size());
 
-      for (auto &xy : continentalnessSplines)
-        continentalnessSplinePoints.emplace_back(xy[0], xy[1]);
+      // the spline tables are shared by every WorldGeneration instance, only fill them once
+      if (continentalnessSplinePoints.empty()) {
+        for (auto &xy : continentalnessSplines)
+          continentalnessSplinePoints.emplace_back(xy[0], xy[1]);
 
-      for (auto &xy : erosionSplines)
-        erosionSplinePoints.emplace_back(xy[0], xy[1]);
+        for (auto &xy : erosionSplines)
+          erosionSplinePoints.emplace_back(xy[0], xy[1]);
 
-      for (auto &xy : erosionSplines)
-        ridgesSplinePoints.emplace_back(xy[0], xy[1]);
+        for (auto &xy : erosionSplines)
+          ridgesSplinePoints.emplace_back(xy[0], xy[1]);
+      }
 
       static std::vector<glm::vec4> continentalnessCoeffs = ComputeMonotonicCubicSplines(continentalnessSplinePoints);
       static std::vector<glm::vec4> erosionCoeffs = ComputeMonotonicCubicSplines(erosionSplinePoints);
@@ -121,23 +131,28 @@ namespace TinyMinecraft {
 
       chunk->ReserveBlocks();
 
-      constexpr int groundHeight = 64;
-      
       const glm::ivec2 &chunkPos = chunk->GetChunkPos();
 
       std::vector<float> continentalnessMap(16 * 16);
       std::vector<float> peaksMap(16 * 16);
       std::vector<float> erosionMap(16 * 16);
 
-      m_baseTerrain->GenUniformGrid2D(continentalnessMap.data(), chunkPos.x * 16.0f, chunkPos.y * 16.0f, 16.0f, 16.0f, 0.1f / 16.0f, 1334);
-      m_baseTerrain->GenUniformGrid2D(peaksMap.data(), chunkPos.x * 16.0f, chunkPos.y * 16.0f, 16.0f, 16.0f, 0.04f / 16.0f, 1335);
-      m_baseTerrain->GenUniformGrid2D(erosionMap.data(), chunkPos.x * 16.0f, chunkPos.y * 16.0f, 16.0f, 16.0f, 0.1f / 16.0f, 1336);
+      m_baseTerrain->GenUniformGrid2D(continentalnessMap.data(), chunkPos.x * 16.0f, chunkPos.y * 16.0f, 16.0f, 16.0f, 0.1f / 16.0f, m_seed + 1334);
+      m_baseTerrain->GenUniformGrid2D(peaksMap.data(), chunkPos.x * 16.0f, chunkPos.y * 16.0f, 16.0f, 16.0f, 0.04f / 16.0f, m_seed + 1335);
+      m_baseTerrain->GenUniformGrid2D(erosionMap.data(), chunkPos.x * 16.0f, chunkPos.y * 16.0f, 16.0f, 16.0f, 0.1f / 16.0f, m_seed + 1336);
+
+      SurfaceMaps surfaceMaps;
+      m_baseTerrain->GenUniformGrid2D(surfaceMaps.temperature.data(), chunkPos.x * 16.0f, chunkPos.y * 16.0f, 16.0f, 16.0f, 0.02f / 16.0f, m_seed + 1338);
+      m_baseTerrain->GenUniformGrid2D(surfaceMaps.humidity.data(), chunkPos.x * 16.0f, chunkPos.y * 16.0f, 16.0f, 16.0f, 0.02f / 16.0f, m_seed + 1339);
+      m_baseTerrain->GenUniformGrid2D(surfaceMaps.stone.data(), chunkPos.x * 16.0f, chunkPos.y * 16.0f, 16.0f, 16.0f, 0.5f / 16.0f, m_seed + 1340);
+      surfaceMaps.heights.fill(-1);
 
       std::vector<float> terrain(16 * 16 * 256);
+      const Utils::TrackedMemory scratch(Utils::MemoryCategory::WorldGenScratch, static_cast<int64_t>(sizeof(float) * (3 * continentalnessMap.size() + terrain.size())));
       // std::vector<float> spaghettiCaves(groundHeight * 16 * 16);
       // std::vector<float> cheeseCaves(groundHeight * 16 * 16);
 
-      m_baseTerrain->GenUniformGrid3D(terrain.data(), chunkPos.x * 16, 0, chunkPos.y * 16, 16, 256, 16, 0.2f/16.0f, 1337);
+      m_baseTerrain->GenUniformGrid3D(terrain.data(), chunkPos.x * 16, 0, chunkPos.y * 16, 16, 256, 16, 0.2f/16.0f, m_seed + 1337);
       // m_caves->GenUniformGrid3D(spaghettiCaves.data(), chunkPos.x * 16, 0, chunkPos.y * 16, 16, groundHeight, 16, 0.8f/16.0f, 1339);
       // m_caves->GenUniformGrid3D(cheeseCaves.data(), chunkPos.x * 16, 0, chunkPos.y * 16, 16, groundHeight, 16, 0.8f/16.0f, 1340);
 
@@ -156,23 +171,9 @@ namespace TinyMinecraft {
           int nx = chunkPos.x * static_cast<int>(CHUNK_WIDTH) + x;
           int nz = chunkPos.y * static_cast<int>(CHUNK_LENGTH) + z;
 
-          double continentalness = continentalnessMap[index2D];
-          continentalness = Utils::ScaleValue(-1.0, 1.0, 0.0, 1.0, continentalness);
-          double continentalnessHeight = ContinentalnessPart(continentalness);
-          continentalnessHeight = Utils::ScaleValue(0.25, 1.0, 0.0, 1.0, continentalnessHeight);
-
-          double erosion = erosionMap[index2D];
-          erosion = Utils::ScaleValue(-1.0, 1.0, 0.0, 1.0, erosion);
-          double erosionHeight = ErosionPart(erosion);
-          erosionHeight = Utils::ScaleValue(0.25, 1.0, 0.0, 1.0, erosionHeight);
-
-          double peaks = peaksMap[index2D];
-          peaks = 1 - std::fabs(3 * std::fabs(peaks) - 2);
-          peaks = Utils::ScaleValue(-1.0, 1.0, 0.0, 1.0, peaks);
-          double peaksHeight = RidgesPart(peaks);
-          peaksHeight = Utils::ScaleValue(0.0, 1.0, -1.0, 1.0, peaksHeight);
+          int baseHeight = GetBaseHeight(continentalnessMap[index2D], erosionMap[index2D], peaksMap[index2D]);
 
-          int baseHeight = groundHeight + (erosionHeight + 0.75f * continentalnessHeight + 0.5f * peaksHeight) * 50.0f;
+          int topY = 0;
 
           for (int y = 0; y < CHUNK_HEIGHT; ++y) {
             caveThickness = Utils::ScaleValue(0.0f, 62.0f, 0.4f, 0.0f, static_cast<float>(y));
@@ -191,17 +192,153 @@ namespace TinyMinecraft {
 
             if (density > 0.0f) {
               chunk->SetBlockAt(glm::vec3(x, y, z), BlockType::Stone);
+              surfaceMaps.heights[index2D] = y;
+              topY = y;
             } else {
               if (y <= 62 && y >= baseHeight - 10) {
                 chunk->SetBlockAt(glm::vec3(x, y, z), BlockType::Water);
+                topY = y;
               }
             }
 
             index++;
           }
+
+          chunk->SetSurfaceHeight(x, z, topY);
           index2D++;
         }
       }
+
+      DecorateSurface(chunk, surfaceMaps);
+    }
+
+    auto WorldGeneration::GetBaseHeight(float continentalnessNoise, float erosionNoise, float peaksNoise) const -> int {
+      constexpr int groundHeight = 64;
+
+      double continentalness = continentalnessNoise;
+      continentalness = Utils::ScaleValue(-1.0, 1.0, 0.0, 1.0, continentalness);
+      double continentalnessHeight = ContinentalnessPart(continentalness);
+      continentalnessHeight = Utils::ScaleValue(0.25, 1.0, 0.0, 1.0, continentalnessHeight);
+
+      double erosion = erosionNoise;
+      erosion = Utils::ScaleValue(-1.0, 1.0, 0.0, 1.0, erosion);
+      double erosionHeight = ErosionPart(erosion);
+      erosionHeight = Utils::ScaleValue(0.25, 1.0, 0.0, 1.0, erosionHeight);
+
+      double peaks = peaksNoise;
+      peaks = 1 - std::fabs(3 * std::fabs(peaks) - 2);
+      peaks = Utils::ScaleValue(-1.0, 1.0, 0.0, 1.0, peaks);
+      double peaksHeight = RidgesPart(peaks);
+      peaksHeight = Utils::ScaleValue(0.0, 1.0, -1.0, 1.0, peaksHeight);
+
+      return groundHeight + (erosionHeight + 0.75f * continentalnessHeight + 0.5f * peaksHeight) * 50.0f;
+    }
+
+    void WorldGeneration::GenerateHeightmap(const glm::ivec2 &origin, int spacing, int size, std::vector<int16_t> &heights, std::vector<BlockType> &blocks) const {
+      PROFILE_FUNCTION(Chunk)
+
+      const size_t count = static_cast<size_t>(size) * size;
+
+      std::vector<float> continentalnessMap(count);
+      std::vector<float> peaksMap(count);
+      std::vector<float> erosionMap(count);
+      std::vector<float> temperatureMap(count);
+      std::vector<float> humidityMap(count);
+      std::vector<float> stoneMap(count);
+      const Utils::TrackedMemory scratch(Utils::MemoryCategory::WorldGenScratch, static_cast<int64_t>(sizeof(float) * 6 * count));
+
+      // every `spacing`th column of the chunk grids: the same noise positions, at a scaled frequency
+      const int x0 = origin.x / spacing;
+      const int z0 = origin.y / spacing;
+      const float scale = static_cast<float>(spacing);
+
+      m_baseTerrain->GenUniformGrid2D(continentalnessMap.data(), x0, z0, size, size, scale * 0.1f / 16.0f, m_seed + 1334);
+      m_baseTerrain->GenUniformGrid2D(peaksMap.data(), x0, z0, size, size, scale * 0.04f / 16.0f, m_seed + 1335);
+      m_baseTerrain->GenUniformGrid2D(erosionMap.data(), x0, z0, size, size, scale * 0.1f / 16.0f, m_seed + 1336);
+      m_baseTerrain->GenUniformGrid2D(temperatureMap.data(), x0, z0, size, size, scale * 0.02f / 16.0f, m_seed + 1338);
+      m_baseTerrain->GenUniformGrid2D(humidityMap.data(), x0, z0, size, size, scale * 0.02f / 16.0f, m_seed + 1339);
+      m_baseTerrain->GenUniformGrid2D(stoneMap.data(), x0, z0, size, size, scale * 0.5f / 16.0f, m_seed + 1340);
+
+      heights.resize(count);
+      blocks.resize(count);
+
+      for (size_t i = 0; i < count; ++i) {
+        // the terrain noise is centered on 0, so without it the ground ends just below the base height
+        const int groundY = GetBaseHeight(continentalnessMap[i], erosionMap[i], peaksMap[i]) - 1;
+
+        if (groundY < Biome::SEA_LEVEL) {
+          heights[i] = static_cast<int16_t>(Biome::SEA_LEVEL);
+          blocks[i] = BlockType::Water;
+          continue;
+        }
+
+        const double temperature = Utils::ScaleValue(-1.0, 1.0, 0.0, 1.0, static_cast<double>(temperatureMap[i]));
+        const double humidity = Utils::ScaleValue(-1.0, 1.0, 0.0, 1.0, static_cast<double>(humidityMap[i]));
+        const double stoneNoise = Utils::ScaleValue(-1.0, 1.0, 0.0, 1.0, static_cast<double>(stoneMap[i]));
+        const SurfaceRules &rules = SelectBiomes(temperature, humidity).first->GetSurfaceRules();
+
+        heights[i] = static_cast<int16_t>(std::min(groundY, CHUNK_HEIGHT - 1));
+        blocks[i] = rules.layerCount == 0 || (rules.hasStoneOutcrops && stoneNoise > Biome::STONE_THRESHOLD)
+          ? BlockType::Stone
+          : rules.layers[0].block;
+      }
+    }
+
+    void WorldGeneration::DecorateSurface(Chunk *chunk, const SurfaceMaps &maps) {
+      PROFILE_SCOPE(Chunk, "WorldGeneration::DecorateSurface")
+
+      int index2D = 0;
+
+      for (int z = 0; z < CHUNK_LENGTH; ++z) {
+        for (int x = 0; x < CHUNK_WIDTH; ++x, ++index2D) {
+          const int surfaceY = maps.heights[index2D];
+          if (surfaceY < 0) {
+            continue;
+          }
+
+          const double temperature = Utils::ScaleValue(-1.0, 1.0, 0.0, 1.0, static_cast<double>(maps.temperature[index2D]));
+          const double humidity = Utils::ScaleValue(-1.0, 1.0, 0.0, 1.0, static_cast<double>(maps.humidity[index2D]));
+          const double stoneNoise = Utils::ScaleValue(-1.0, 1.0, 0.0, 1.0, static_cast<double>(maps.stone[index2D]));
+
+          const Biome *biome = SelectBiomes(temperature, humidity).first;
+
+#ifdef WORLDGEN_NaiveSurfaceRules
+          const glm::ivec3 globalPos = chunk->GetGlobalCoords(glm::vec3(x, 0, z));
+
+          for (int y = 0; y <= surfaceY; ++y) {
+            if (chunk->GetBlockAt(x, y, z) != BlockType::Stone) {
+              continue;
+            }
+
+            const BlockType block = biome->GenerateBlock(globalPos.x, y, globalPos.z, surfaceY, stoneNoise);
+            if (block != BlockType::Air) {
+              chunk->SetBlockAt(x, y, z, block);
+            }
+          }
+#else
+          const SurfaceRules &rules = biome->GetSurfaceRules();
+
+          if (rules.hasStoneOutcrops && stoneNoise > Biome::STONE_THRESHOLD) {
+            continue;
+          }
+
+          // layers are written top-down as spans of the column, over its stone only so the air and water of
+          // overhangs and cave openings stay; stone stays below them
+          int top = surfaceY;
+          for (int i = 0; i < rules.layerCount && top >= 0; ++i) {
+            const SurfaceLayer &layer = rules.layers[i];
+            const int count = std::min(layer.depth, top + 1);
+
+            chunk->ReplaceInColumn(x, top - count + 1, z, count, BlockType::Stone, layer.block);
+            top -= count;
+          }
+
+          if (rules.shoreBlock != BlockType::Air && surfaceY <= Biome::SEA_LEVEL) {
+            chunk->SetBlockAt(x, surfaceY, z, rules.shoreBlock);
+          }
+#endif
+        }
+      }
     }
 
     void WorldGeneration::GenerateFeatures(Chunk *chunk) {
@@ -209,80 +346,80 @@ namespace TinyMinecraft {
       
       constexpr float TREE_GENERATION_THRESHOLD = 0.95f;
       constexpr float GRASS_GENERATION_THRESHOLD = 0.80f;
-      constexpr int TREE_RADIUS = 2;
+      const int TREE_RADIUS = m_tree.GetRadius();
       constexpr float TREE_NOISE_SCALE = 10.0f;
       constexpr float GRASS_NOISE_SCALE = 100.0f;
 
-      std::unordered_set<glm::ivec2, Utils::IVec2Hash> reservedPositions;
+      const glm::ivec2 &chunkPos = chunk->GetChunkPos();
+
+      std::array<float, CHUNK_WIDTH * CHUNK_LENGTH> grassMap;
+      std::array<float, CHUNK_WIDTH * CHUNK_LENGTH> treeMap;
+      m_featureNoise->GenUniformGrid2D(grassMap.data(), chunkPos.x * 16.0f, chunkPos.y * 16.0f, 16.0f, 16.0f, 1.0f, m_seed + 100);
+      m_featureNoise->GenUniformGrid2D(treeMap.data(), chunkPos.x * 16.0f, chunkPos.y * 16.0f, 16.0f, 16.0f, 1.0f / 16.0f, m_seed + 101);
 
-      for (int z = 0; z < CHUNK_LENGTH; ++z) {
-        for (int x = 0; x < CHUNK_WIDTH; ++x) {
-          glm::ivec2 position(x, z);
+      // columns already taken by a feature, indexed like the noise grids
+      std::bitset<CHUNK_WIDTH * CHUNK_LENGTH> reserved;
+      FeatureBatches outside;
 
-          if (reservedPositions.find(position) != reservedPositions.end()) {
+      int index2D = 0;
+
+      for (int z = 0; z < CHUNK_LENGTH; ++z) {
+        for (int x = 0; x < CHUNK_WIDTH; ++x, ++index2D) {
+          if (reserved[index2D]) {
             continue;
           }
 
-          int globalX = CHUNK_WIDTH * chunk->GetChunkPos().x + x;
-          int globalZ = CHUNK_WIDTH * chunk->GetChunkPos().y + z;
+          const int surfaceY = chunk->GetSurfaceHeight(x, z);
 
-          double grassNoise = m_featureNoise->GenSingle2D(globalX, globalZ, 100);
+          double grassNoise = grassMap[index2D];
           grassNoise = Utils::ScaleValue(-1.0, 1.0, 0.0, 1.0, grassNoise);
 
           // double grassNoise = Math::NoiseManager::GetImprovedSimplexNoise(Math::Noise::Grass, glm::vec2(globalX * GRASS_NOISE_SCALE, globalZ * GRASS_NOISE_SCALE));
-          if (grassNoise > GRASS_GENERATION_THRESHOLD) {
-            int surfaceHeight = chunk->GetSurfaceHeight(x, z);
-
-            if (chunk->GetBlockAt(x, surfaceHeight, z) == BlockType::Grass) {
-              chunk->SetBlockAt(x, surfaceHeight + 1, z, BlockType::TallGrass);
-              reservedPositions.insert(position);
-            }
-          }
-
-          if (reservedPositions.find(position) != reservedPositions.end()) {
+          if (grassNoise > GRASS_GENERATION_THRESHOLD && chunk->GetBlockAt(x, surfaceY, z) == BlockType::Grass) {
+            chunk->SetBlockAt(x, surfaceY + 1, z, BlockType::TallGrass);
+            reserved.set(index2D);
             continue;
           }
 
-          double treeNoise = m_featureNoise->GenSingle2D(globalX / 16.0f, globalZ / 16.0f, 101);
+          double treeNoise = treeMap[index2D];
           treeNoise = Utils::ScaleValue(-1.0, 1.0, 0.0, 1.0, treeNoise);
           // double treeNoise = Math::NoiseManager::GetImprovedSimplexNoise(Math::Noise::Tree, glm::vec2(globalX * TREE_NOISE_SCALE, globalZ * TREE_NOISE_SCALE));
-          if (treeNoise >= TREE_GENERATION_THRESHOLD) {
-            int surfaceY = chunk->GetSurfaceHeight(x, z);
-
-            if (CanTreeSpawn(chunk, x, surfaceY, z, TREE_RADIUS)) {
-              SpawnTree(chunk, x, surfaceY, z);
-              for (int dx = -TREE_RADIUS; dx <= TREE_RADIUS; ++dx) {
-                for (int dz = -TREE_RADIUS; dz <= TREE_RADIUS; ++dz) {
-                  int localX = x + dx;
-                  int localZ = z + dz;
-
-                  if (localX < 0 || localZ < 0 || localX >= CHUNK_WIDTH || localZ >= CHUNK_LENGTH) {
-                    continue;
-                  }
-                  reservedPositions.insert(glm::ivec2(localX, localZ));
-                }
+          if (treeNoise >= TREE_GENERATION_THRESHOLD && CanTreeSpawn(chunk, x, surfaceY, z, TREE_RADIUS)) {
+            m_tree.Stamp(chunk, glm::ivec3(x, surfaceY + 1, z), outside);
+
+            const int minX = std::max(x - TREE_RADIUS, 0);
+            const int maxX = std::min(x + TREE_RADIUS, CHUNK_WIDTH - 1);
+            const int minZ = std::max(z - TREE_RADIUS, 0);
+            const int maxZ = std::min(z + TREE_RADIUS, CHUNK_LENGTH - 1);
+
+            for (int localZ = minZ; localZ <= maxZ; ++localZ) {
+              for (int localX = minX; localX <= maxX; ++localX) {
+                reserved.set(localZ * CHUNK_WIDTH + localX);
               }
             }
           }
         }
       }
+
+      PostFeatureBatches(chunk, outside);
     }
 
-    void WorldGeneration::LoadUnloadedBlocks(Chunk *chunk) {
-      glm::ivec2 chunkPos = chunk->GetChunkPos();
+    void WorldGeneration::PostFeatureBatches(Chunk *chunk, FeatureBatches &outside) {
+      const glm::ivec2 chunkPos = chunk->GetChunkPos();
 
-      if (!m_unloadedBlocks.contains(chunkPos)) {
-        return;
-      }
+      for (int i = 0; i < outside.size(); ++i) {
+        if (outside[i].empty()) {
+          continue;
+        }
 
-      auto a = m_unloadedBlocks.at(chunkPos);
+        const glm::ivec2 neighborPos = chunkPos + glm::ivec2(i % 3 - 1, i / 3 - 1);
+        if (!m_world.HasChunk(neighborPos)) {
+          Utils::Logger::Warning("Chunk {} dropped features for missing neighbor {}", chunkPos, neighborPos);
+          continue;
+        }
 
-      for (auto &[pos, block] : m_unloadedBlocks.at(chunkPos)) {
-        glm::vec3 globalPos = glm::vec3(CHUNK_WIDTH * chunkPos.x + pos.x, pos.y, CHUNK_WIDTH * chunkPos.y + pos.y);
-        chunk->SetBlockAt(pos, block);
+        m_world.GetChunkAt(neighborPos)->PostFeatureBatch(std::make_unique<FeatureBatch>(FeatureBatch{ chunkPos, std::move(outside[i]) }));
       }
-
-      m_unloadedBlocks.erase(chunkPos);
     }
 
     auto WorldGeneration::SelectBiomes(double temperature, double humidity) const -> std::pair<const Biome*, const Biome*> {
@@ -308,99 +445,6 @@ namespace TinyMinecraft {
       return {primaryBiome, secondaryBiome};
     }
 
-    void WorldGeneration::SpawnTree(Chunk *chunk, int x, int surfaceY, int z) {
-
-      int structure[7][5][5] = {
-        {
-          {0,      0,      0,      0,    0},
-          {0,      0,      0,      0,    0},
-          {0,      0,      Log,    0,    0},
-          {0,      0,      0,      0,    0},
-          {0,      0,      0,      0,    0},
-        },
-        {
-          {0,      0,      0,      0,    0},
-          {0,      0,      0,      0,    0},
-          {0,      0,      Log,    0,    0},
-          {0,      0,      0,      0,    0},
-          {0,      0,      0,      0,    0},
-        },
-        {
-          {0,      0,      0,      0,    0},
-          {0,      0,      0,      0,    0},
-          {0,      0,      Log,    0,    0},
-          {0,      0,      0,      0,    0},
-          {0,      0,      0,      0,    0},
-        },
-        {
-          {0,      Leaves, Leaves, Leaves,       0},
-          {Leaves, Leaves, Leaves, Leaves,    Leaves},
-          {Leaves, Leaves, Log,    Leaves,      Leaves},
-          {Leaves, Leaves, Leaves, Leaves,    Leaves},
-          {0,      Leaves, Leaves, Leaves,       0},
-        },
-        {
-          {0,       Leaves,       Leaves,       Leaves,       0},
-          {Leaves,      Leaves,     Leaves,     Leaves,    Leaves},
-          {Leaves,      Leaves,     Log,      Leaves,      Leaves},
-          {Leaves,      Leaves,     Leaves,     Leaves,    Leaves},
-          {0,       Leaves,       Leaves,       Leaves,       0},
-        },
-        {
-          {0,       0,      0,      0,    0},
-          {0,       Leaves,       Leaves,       Leaves,       0},
-          {0,       Leaves,       Log,      Leaves,     0},
-          {0,       Leaves,       Leaves,       Leaves,       0},
-          {0,       0,      0,      0,    0},
-        },
-        {
-          {0,       0,      0,      0,    0},
-          {0,       0,      Leaves,     0,      0},
-          {0,       Leaves,       Leaves,       Leaves,       0},
-          {0,       0,      Leaves,     0,      0},
-          {0,       0,      0,      0,    0},
-        },
-      };
-
-      for (int dy = 0; dy < 7; ++dy) {
-        for (int dx = -2; dx <= 2; ++dx) {
-          for (int dz = -2; dz <= 2; ++dz) {
-            int localX = x + dx;
-            int localZ = z + dz;
-            int localY = surfaceY + 1 + dy;
-
-            auto block = static_cast<BlockType>(structure[dy][dx + 2][dz + 2]);
-
-            if (block == 0) {
-              continue;
-            }
-
-            if (localY < 0 || localY >= CHUNK_HEIGHT) {
-              continue;
-            }
-
-            // place this in list of blocks to be loaded again later
-
-            if (localX < 0 || localZ < 0 || localX >= CHUNK_WIDTH || localZ >= CHUNK_LENGTH) {
-              int globalX = chunk->GetChunkPos().x * CHUNK_WIDTH + localX;
-              int globalY = localY;
-              int globalZ = chunk->GetChunkPos().y * CHUNK_LENGTH + localZ;
-
-
-              glm::vec3 globalPos { globalX, globalY, globalZ };
-              glm::ivec2 neighborChunkPos = m_world.GetChunkPosFromCoords(globalPos);
-              glm::vec3 neighborLocalPos = m_world.GetLocalBlockCoords(globalPos);
-
-              m_unloadedBlocks[neighborChunkPos].emplace_back(neighborLocalPos, block);
-              continue;
-            }
-
-            chunk->SetBlockAt(localX, localY, localZ, block);
-          }
-        }
-      }
-    }
-
     auto WorldGeneration::CanTreeSpawn(Chunk *chunk, int x, int surfaceY, int z, int radius) -> bool {
       if (chunk->GetBlockAt(x, surfaceY, z) != BlockType::Grass) {
         return false;
@@ -1,23 +1,61 @@
 #include "Application/Game.h"
+#include "Application/OcclusionBenchmark.h"
 #include "Utils/Logger.h"
+#include "Utils/MemoryTracker.h"
 #include "Utils/Profiler.h"
+#include "Utils/SamplingProfiler.h"
 #include "Utils/utils.h"
+#include "World/Block.h"
+#include "World/ChunkLifecycle.h"
+#include <string>
+#include <string_view>
 #include <unistd.h>
 
 using namespace TinyMinecraft;
 
-auto main() -> int {
+auto main(int argc, char **argv) -> int {
   // Utils::Logger::Message("Press anything to start. PID: {}", getpid());
   // std::cin.get();
 
   Utils::SetThreadName("main");
 
+  if (argc > 1) {
+    const std::string_view option = argv[1];
+
+    // replays the camera poses saved with F6 through the chunk culler
+    if (option == "--bench-occlusion") {
+      World::BlockData::Initialize();
+
+      return Application::RunOcclusionBenchmark(argc > 2 ? argv[2] : "../data/occlusion_poses.json") ? 0 : 1;
+    }
+
+    // captures the first seconds of the game as a trace, like F7 later on
+    if (option == "--trace") {
+      Utils::Profiler::BeginCapture(argc > 2 ? std::stof(argv[2]) : UTILS_TRACE_SECONDS);
+    }
+
+    // samples stacks from the start, until F9 or exit
+    if (option == "--sample") {
+      Utils::SamplingProfiler::Start(argc > 2 ? std::stoi(argv[2]) : UTILS_SAMPLING_FREQUENCY);
+    }
+  }
+
   Application::Game game;
   game.Run();
 
+  Utils::SamplingProfiler::Stop();
+
 #ifdef UTILS_RunProfile
+  // a capture still running is cut short and written
+  Utils::Profiler::EndCapture();
   Utils::Profiler::LogSummary();
 #endif
 
+#ifdef UTILS_ChunkLifecycle
+  World::ChunkLifecycle::LogSummary();
+#endif
+
+  Utils::MemoryTracker::LogSummary();
+
   return 0;
 }
@@ -0,0 +1,120 @@
+#include "Graphics/RangeAllocator.h"
+#include "Utils/Logger.h"
+#include "Utils/utils.h"
+#include <string_view>
+
+// Bookkeeping test of the allocator behind the chunk regions: splitting and coalescing free ranges, first-fit
+// reuse of freed ranges and growing. Needs no GL context.
+
+using namespace TinyMinecraft;
+
+namespace {
+
+  bool s_passed = true;
+
+  void Expect(bool condition, std::string_view what) {
+    if (!condition) {
+      Utils::Logger::Error("Failed: {}", what);
+      s_passed = false;
+    }
+  }
+
+  void TestSplit() {
+    Graphics::RangeAllocator allocator(100);
+
+    Expect(allocator.Allocate(30) == 0u, "split: first allocation at 0");
+    Expect(allocator.Allocate(20) == 30u, "split: second allocation right after the first");
+    Expect(allocator.GetFreeSize() == 50, "split: free size after two allocations");
+    Expect(allocator.GetFreeRangeCount() == 1, "split: one free range left at the end");
+    Expect(allocator.GetLargestFreeRange() == 50, "split: largest free range is the tail");
+
+    Expect(allocator.Allocate(50) == 50u, "split: exact fit of the tail");
+    Expect(allocator.GetFreeRangeCount() == 0, "split: no free range when full");
+    Expect(!allocator.Allocate(1), "split: nothing fits when full");
+    Expect(!allocator.Allocate(0), "split: empty allocations are refused");
+  }
+
+  void TestCoalesce() {
+    Graphics::RangeAllocator allocator(100);
+    Expect(allocator.Allocate(10) == 0u, "coalesce: setup a");
+    Expect(allocator.Allocate(10) == 10u, "coalesce: setup b");
+    Expect(allocator.Allocate(10) == 20u, "coalesce: setup c");
+    Expect(allocator.Allocate(70) == 30u, "coalesce: setup d");
+
+    allocator.Free(0, 10);
+    allocator.Free(20, 10);
+    Expect(allocator.GetFreeRangeCount() == 2, "coalesce: ranges apart stay apart");
+    Expect(allocator.GetLargestFreeRange() == 10, "coalesce: largest of two separate ranges");
+
+    // joins the free ranges before and after it into one
+    allocator.Free(10, 10);
+    Expect(allocator.GetFreeRangeCount() == 1, "coalesce: freeing between two free ranges merges all three");
+    Expect(allocator.GetLargestFreeRange() == 30, "coalesce: merged range spans all three");
+
+    allocator.Free(30, 70);
+    Expect(allocator.GetFreeRangeCount() == 1, "coalesce: freeing before the end merges with the range before");
+    Expect(allocator.GetFreeSize() == 100 && allocator.GetLargestFreeRange() == 100, "coalesce: everything free again");
+  }
+
+  void TestFirstFitReuse() {
+    Graphics::RangeAllocator allocator(100);
+    Expect(allocator.Allocate(20) == 0u, "first fit: setup a");
+    Expect(allocator.Allocate(10) == 20u, "first fit: setup b");
+    Expect(allocator.Allocate(40) == 30u, "first fit: setup c");
+    Expect(allocator.Allocate(10) == 70u, "first fit: setup d");
+
+    // free ranges of 20 at 0, 40 at 30 and 20 at 80
+    allocator.Free(0, 20);
+    allocator.Free(30, 40);
+
+    Expect(allocator.Allocate(15) == 0u, "first fit: lowest range that fits is reused");
+    Expect(allocator.Allocate(10) == 30u, "first fit: too small a remainder is skipped");
+    Expect(allocator.Allocate(5) == 15u, "first fit: remainder of a reused range is reused");
+    Expect(allocator.Allocate(30) == 40u, "first fit: rest of the freed range");
+    Expect(allocator.Allocate(20) == 80u, "first fit: tail");
+    Expect(allocator.GetFreeSize() == 0, "first fit: everything allocated");
+  }
+
+  void TestGrow() {
+    Graphics::RangeAllocator allocator(50);
+    Expect(allocator.Allocate(40) == 0u, "grow: setup");
+
+    Expect(!allocator.Allocate(20), "grow: does not fit before growing");
+
+    // merges with the free tail of the old capacity
+    allocator.Grow(100);
+    Expect(allocator.GetCapacity() == 100, "grow: new capacity");
+    Expect(allocator.GetFreeRangeCount() == 1, "grow: new space merged with the free tail");
+    Expect(allocator.Allocate(20) == 40u, "grow: allocation spans the old and new space");
+
+    allocator.Grow(80);
+    Expect(allocator.GetCapacity() == 100, "grow: never shrinks");
+
+    Graphics::RangeAllocator full(10);
+    Expect(full.Allocate(10) == 0u, "grow: setup of a full allocator");
+    full.Grow(30);
+    Expect(full.GetFreeRangeCount() == 1 && full.GetFreeSize() == 20, "grow: new space of a full allocator");
+    Expect(full.Allocate(20) == 10u, "grow: allocation at the old capacity");
+
+    Graphics::RangeAllocator empty(0);
+    Expect(!empty.Allocate(1), "grow: nothing fits without capacity");
+    empty.Grow(16);
+    Expect(empty.Allocate(16) == 0u, "grow: from no capacity");
+  }
+
+}
+
+auto main() -> int {
+  Utils::SetThreadName("main");
+
+  TestSplit();
+  TestCoalesce();
+  TestFirstFitReuse();
+  TestGrow();
+
+  if (s_passed) {
+    Utils::Logger::Message("All range allocator checks passed.");
+  }
+
+  return s_passed ? 0 : 1;
+}
@@ -0,0 +1,232 @@
+#include "Graphics/Device.h"
+#include "Graphics/Renderer.h"
+#include "Graphics/RenderState.h"
+#include "Scene/PlayerCameras.h"
+#include "Utils/Logger.h"
+#include "Utils/defs.h"
+#include "Utils/utils.h"
+#include "World/Block.h"
+#include "World/World.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Regression test of what the renderer sends to the driver, runs without a window or GPU. Renders the world around
+// every camera pose in the file on the Null graphics device, until everything in view distance is uploaded and then
+// for a few more frames, and fails if any frame issued more draws, uploaded more bytes or allocated more buffers than
+// the budgets in the file allow.
+
+using namespace TinyMinecraft;
+
+namespace {
+
+  // same as the game's window and camera
+  constexpr float viewportWidth = 1920.0f;
+  constexpr float viewportHeight = 1080.0f;
+  constexpr float fov = 45.0f;
+  constexpr float nearPlane = 0.1f;
+  constexpr float farPlane = 2048.0f;
+
+  struct CameraPose {
+    glm::vec3 position;
+    float yaw, pitch;
+  };
+
+  struct FrameBudget {
+    int drawCalls;
+    size_t uploadedBytes;
+    int bufferAllocations;
+  };
+
+  // placed directly instead of following a player
+  class PoseCamera : public Scene::PlayerCamera {
+  public:
+    void OnPlayerLook(const Event::PlayerLookedEvent &) override {}
+    void OnPlayerMove(const Event::PlayerMovedEvent &) override {}
+
+    void SetPose(const CameraPose &pose) {
+      glm::vec3 front;
+      front.x = cos(glm::radians(pose.yaw)) * cos(glm::radians(pose.pitch));
+      front.y = sin(glm::radians(pose.pitch));
+      front.z = sin(glm::radians(pose.yaw)) * cos(glm::radians(pose.pitch));
+      front = glm::normalize(front);
+
+      const glm::vec3 right = glm::normalize(glm::cross(front, glm::vec3(0.0f, 1.0f, 0.0f)));
+      const glm::vec3 up = glm::normalize(glm::cross(right, front));
+
+      const glm::mat4 projection = glm::perspective(glm::radians(fov), viewportWidth / viewportHeight, nearPlane, farPlane);
+      m_viewProjection = projection * glm::lookAt(pose.position, pose.position + front, up);
+      m_position = pose.position;
+    }
+  };
+
+  auto ReadBudget(const nlohmann::json &json) -> FrameBudget {
+    return FrameBudget{
+      json["drawCalls"].get<int>(),
+      json["uploadedBytes"].get<size_t>(),
+      json["bufferAllocations"].get<int>()
+    };
+  }
+
+  auto IsWithinBudget(const Graphics::Device::FrameStats &stats, const FrameBudget &budget) -> bool {
+    return stats.drawCalls <= budget.drawCalls
+      && stats.uploadedBytes <= budget.uploadedBytes
+      && stats.bufferAllocations <= budget.bufferAllocations;
+  }
+
+  auto IsViewLoaded(const World::World &world, const glm::ivec2 &center) -> bool {
+    constexpr int radius = GFX_RENDER_DISTANCE;
+
+    for (int dz = -radius; dz <= radius; ++dz) {
+      for (int dx = -radius; dx <= radius; ++dx) {
+        if (dx * dx + dz * dz <= radius * radius && !world.IsChunkLoaded(center + glm::ivec2(dx, dz))) {
+          return false;
+        }
+      }
+    }
+
+    return true;
+  }
+
+  auto CheckRenderBudget(const std::string &path) -> bool {
+    std::ifstream file(path);
+
+    if (!file.is_open()) {
+      Utils::Logger::Error("Json: file cannot open");
+      return false;
+    }
+
+    nlohmann::json json;
+    file >> json;
+    file.close();
+
+    if (!json["seed"].is_number() || !json["poses"].is_array() || !json["budgets"].is_object()) {
+      Utils::Logger::Error("Invalid render budget at path {}: Missing attributes.", path);
+      return false;
+    }
+
+    const int seed = json["seed"];
+    const int steadyFrames = json.value("steadyFrames", 30);
+    const double timeoutSeconds = json.value("timeoutSeconds", 600.0);
+    const FrameBudget loadingBudget = ReadBudget(json["budgets"]["loading"]);
+    const FrameBudget steadyBudget = ReadBudget(json["budgets"]["steady"]);
+
+    if (!Graphics::Device::Initialize(Graphics::DeviceBackend::Null)) {
+      Utils::Logger::Error("Graphics: Error initializing the null device.");
+      return false;
+    }
+
+    Graphics::Renderer renderer(viewportWidth, viewportHeight);
+    World::World world(seed);
+    const auto camera = std::make_shared<PoseCamera>();
+
+    bool passed = true;
+
+    const auto renderFrame = [&](const CameraPose &pose) -> const Graphics::Device::FrameStats & {
+      world.Update(pose.position);
+
+      renderer.Begin3D(camera);
+      renderer.RenderWorld(world);
+      renderer.End3D();
+
+      Graphics::RenderState::EndFrame();
+      Graphics::Device::EndFrame();
+      return Graphics::Device::GetFrameStats();
+    };
+
+    const auto checkFrame = [&](const Graphics::Device::FrameStats &stats, const FrameBudget &budget, size_t poseIndex, int frame) {
+      if (!IsWithinBudget(stats, budget)) {
+        Utils::Logger::Error("Pose {} frame {}: {} draws, {} bytes uploaded, {} buffers allocated, over {} / {} / {}.",
+          poseIndex, frame, stats.drawCalls, stats.uploadedBytes, stats.bufferAllocations,
+          budget.drawCalls, budget.uploadedBytes, budget.bufferAllocations);
+        passed = false;
+      }
+    };
+
+    for (size_t i = 0; i < json["poses"].size(); ++i) {
+      const auto &poseJson = json["poses"][i];
+      const auto &position = poseJson["position"];
+      const CameraPose pose {
+        glm::vec3(position[0].get<float>(), position[1].get<float>(), position[2].get<float>()),
+        poseJson["yaw"].get<float>(),
+        poseJson["pitch"].get<float>()
+      };
+
+      camera->SetPose(pose);
+      const glm::ivec2 chunkPos = world.GetChunkPosFromCoords(pose.position);
+      const auto start = std::chrono::steady_clock::now();
+
+      // the pose is loaded once a frame starting with every chunk in view Loaded and the workers idle has
+      // submitted no new work and uploaded all meshes; the budgets play no part in it, so a frame over them
+      // fails the check instead of holding up the loading
+      int frame = 0;
+      Graphics::Device::FrameStats loadingMax, steadyMax;
+
+      const auto trackMax = [](Graphics::Device::FrameStats &max, const Graphics::Device::FrameStats &stats) {
+        max.drawCalls = std::max(max.drawCalls, stats.drawCalls);
+        max.uploadedBytes = std::max(max.uploadedBytes, stats.uploadedBytes);
+        max.bufferAllocations = std::max(max.bufferAllocations, stats.bufferAllocations);
+      };
+
+      while (true) {
+        const bool isViewLoaded = IsViewLoaded(world, chunkPos);
+        const bool isWorldIdle = !world.HasPendingTasks();
+        const size_t submittedTaskCount = world.GetSubmittedTaskCount();
+
+        const Graphics::Device::FrameStats &stats = renderFrame(pose);
+        checkFrame(stats, loadingBudget, i, frame++);
+        trackMax(loadingMax, stats);
+
+        if (isViewLoaded && isWorldIdle && world.GetSubmittedTaskCount() == submittedTaskCount
+            && renderer.GetStats().pendingMeshes == 0) {
+          break;
+        }
+
+        if (std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() > timeoutSeconds) {
+          Utils::Logger::Error("Pose {}: not loaded after {} s.", i, timeoutSeconds);
+          return false;
+        }
+
+        // leaves the workers some time on machines with few cores
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+
+      // a chunk is only drawn a frame after its upload
+      const Graphics::Device::FrameStats &lastLoadingStats = renderFrame(pose);
+      checkFrame(lastLoadingStats, loadingBudget, i, frame++);
+      trackMax(loadingMax, lastLoadingStats);
+
+      const int loadingFrames = frame;
+      for (int steadyFrame = 0; steadyFrame < steadyFrames; ++steadyFrame) {
+        const Graphics::Device::FrameStats &stats = renderFrame(pose);
+        checkFrame(stats, steadyBudget, i, frame++);
+        trackMax(steadyMax, stats);
+      }
+
+      Utils::Logger::Message("Pose {}: loaded in {} frames, at most {} draws, {} bytes uploaded and {} buffers allocated per frame; "
+        "at most {} draws, {} bytes uploaded and {} buffers allocated per frame after.",
+        i, loadingFrames, loadingMax.drawCalls, loadingMax.uploadedBytes, loadingMax.bufferAllocations,
+        steadyMax.drawCalls, steadyMax.uploadedBytes, steadyMax.bufferAllocations);
+    }
+
+    if (passed) {
+      Utils::Logger::Message("All {} poses within the render budget.", json["poses"].size());
+    }
+
+    return passed;
+  }
+
+}
+
+auto main(int argc, char **argv) -> int {
+  Utils::SetThreadName("main");
+  World::BlockData::Initialize();
+
+  return CheckRenderBudget(argc > 1 ? argv[1] : "../data/render_budget.json") ? 0 : 1;
+}
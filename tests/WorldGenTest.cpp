@@ -0,0 +1,150 @@
+#include "Utils/Logger.h"
+#include "Utils/mathgl.h"
+#include "Utils/utils.h"
+#include "World/Block.h"
+#include "World/World.h"
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <nlohmann/json.hpp>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Generation regression test. Generates the chunks listed in the golden file once with a single worker and once
+// with several, then compares the block hashes of both runs with each other and with the golden values. With
+// --record it overwrites the golden values instead, when both runs agree. Without golden values it is skipped.
+
+using namespace TinyMinecraft;
+
+namespace {
+
+  using ChunkHashes = std::map<std::string, std::string>;
+
+  // exit codes, CTest counts the last one as skipped
+  constexpr int TEST_PASSED = 0;
+  constexpr int TEST_FAILED = 1;
+  constexpr int TEST_SKIPPED = 77;
+
+  auto ToHex(uint64_t hash) -> std::string {
+    std::ostringstream oss;
+    oss << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return oss.str();
+  }
+
+  auto GetChunkKey(const glm::ivec2 &chunkPos) -> std::string {
+    return std::to_string(chunkPos.x) + "," + std::to_string(chunkPos.y);
+  }
+
+  auto GenerateHashes(int seed, unsigned int workerCount, const std::vector<glm::ivec2> &chunkPositions) -> ChunkHashes {
+    World::World world(seed, workerCount);
+    world.GenerateChunks(chunkPositions);
+
+    ChunkHashes hashes;
+    for (const glm::ivec2 &chunkPos : chunkPositions) {
+      hashes[GetChunkKey(chunkPos)] = ToHex(world.GetChunkAt(chunkPos)->HashBlocks());
+    }
+
+    return hashes;
+  }
+
+  auto CheckWorldGeneration(const std::string &path, bool record) -> int {
+    std::ifstream file(path);
+
+    if (!file.is_open()) {
+      Utils::Logger::Error("Json: file cannot open");
+      return TEST_FAILED;
+    }
+
+    nlohmann::json json;
+    file >> json;
+    file.close();
+
+    if (!json["seed"].is_number() || !json["chunks"].is_array()) {
+      Utils::Logger::Error("Invalid world generation hashes at path {}: Missing attributes.", path);
+      return TEST_FAILED;
+    }
+
+    const int seed = json["seed"];
+    std::vector<glm::ivec2> chunkPositions;
+    for (const auto &xz : json["chunks"]) {
+      chunkPositions.emplace_back(xz[0].get<int>(), xz[1].get<int>());
+    }
+
+    const unsigned int workerCount = std::max(std::thread::hardware_concurrency(), 2u);
+    const ChunkHashes serial = GenerateHashes(seed, 1, chunkPositions);
+    const ChunkHashes parallel = GenerateHashes(seed, workerCount, chunkPositions);
+
+    bool passed = true;
+
+    for (const auto &[key, hash] : serial) {
+      if (parallel.at(key) != hash) {
+        Utils::Logger::Error("Chunk {}: 1 worker gave {}, {} workers gave {}.", key, hash, workerCount, parallel.at(key));
+        passed = false;
+      }
+    }
+
+    if (record) {
+      if (!passed) {
+        Utils::Logger::Error("Generation is not deterministic, refusing to record hashes.");
+        return TEST_FAILED;
+      }
+
+      for (const auto &[key, hash] : serial) {
+        json["hashes"][key] = hash;
+      }
+
+      std::ofstream out(path);
+      out << json.dump(2) << '\n';
+      Utils::Logger::Message("Recorded {} chunk hashes for seed {}.", serial.size(), seed);
+      return TEST_PASSED;
+    }
+
+    // without golden values only the determinism above is checked, which is not enough to pass
+    if (!json["hashes"].is_object() || json["hashes"].empty()) {
+      if (!passed) {
+        return TEST_FAILED;
+      }
+
+      Utils::Logger::Warning("{} has no golden hashes, record them with WorldGenTest --record.", path);
+      return TEST_SKIPPED;
+    }
+
+    for (const auto &[key, hash] : serial) {
+      if (!json["hashes"].contains(key)) {
+        Utils::Logger::Error("Chunk {}: no golden hash, record it with WorldGenTest --record.", key);
+        passed = false;
+        continue;
+      }
+
+      const std::string expected = json["hashes"][key];
+      if (expected != hash) {
+        Utils::Logger::Error("Chunk {}: expected {}, generated {}.", key, expected, hash);
+        passed = false;
+      }
+    }
+
+    if (passed) {
+      Utils::Logger::Message("All {} chunks match for seed {} with 1 and {} workers.", serial.size(), seed, workerCount);
+    }
+
+    return passed ? TEST_PASSED : TEST_FAILED;
+  }
+
+}
+
+// WorldGenTest [--record] [path]
+auto main(int argc, char **argv) -> int {
+  Utils::SetThreadName("main");
+  World::BlockData::Initialize();
+
+  const bool record = argc > 1 && std::string_view(argv[1]) == "--record";
+  const int pathIndex = record ? 2 : 1;
+  const std::string path = argc > pathIndex ? argv[pathIndex] : "../data/worldgen_hashes.json";
+
+  return CheckWorldGeneration(path, record);
+}